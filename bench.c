@@ -0,0 +1,686 @@
+/**
+ * Author: Aidan Lynch
+ *
+ * simplex_bench: times libsimplex on generated games and reports each solve
+ * as JSON, to track pivot throughput and scaling across versions
+ */
+
+#include "simplex.h"
+#include "parse.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include <getopt.h>
+#include <time.h>
+#include <sys/resource.h>
+
+// games generated when none are given
+#define DEFAULT_KINDS "dense,sparse,degenerate,blotto,rpsls"
+#define DEFAULT_SIZES "50,100,200"
+
+// fraction of the entries of a sparse game that are nonzero by default
+#define DEFAULT_DENSITY 0.05
+
+// battlefields of a colonel blotto game
+#define BLOTTO_FIELDS 3
+
+// integer games have this many more columns than rows and payoffs up to this
+// magnitude, so some columns stay out of the optimal support
+#define INTEGER_EXTRA_COLS 7
+#define INTEGER_MAX_PAYOFF 10
+
+// with --check, values may differ from the double precision tableau by this
+// much, and by the larger amount in single precision
+#define CHECK_TOLERANCE 1e-6
+#define FLOAT_CHECK_TOLERANCE 1e-3
+
+/**
+ * Print the usage statement for this program.
+ */
+void print_usage() {
+    printf("usage: simplex_bench [options]\n");
+    printf("options:\n");
+    printf("\t--kinds K: comma separated games to generate, default " DEFAULT_KINDS "\n");
+    printf("\t\tdense: uniform payoffs in [-1, 1]\n");
+    printf("\t\tsparse: like dense with most payoffs 0, solved from its nonzero entries\n");
+    printf("\t\tdegenerate: payoffs of 0 or 1, with many ties in the ratio test\n");
+    printf("\t\tinteger: integer payoffs in [-%d, %d] with %d more columns than rows\n", INTEGER_MAX_PAYOFF,
+           INTEGER_MAX_PAYOFF, INTEGER_EXTRA_COLS);
+    printf("\t\tblotto: colonel blotto with %d battlefields and as many soldiers as give at least the size\n", BLOTTO_FIELDS);
+    printf("\t\trpsls: rock paper scissors with the odd number of throws at most the size\n");
+    printf("\t--sizes N: comma separated numbers of rows and columns, default " DEFAULT_SIZES "\n");
+    printf("\t--repeat R: games of each kind and size, default 1\n");
+    printf("\t--seed S: seed of the generated payoffs, default 1\n");
+    printf("\t--density D: fraction of nonzero payoffs in sparse games, default %g\n", DEFAULT_DENSITY);
+    printf("\t--threads N: pivot with N threads, default 1\n");
+    printf("\t--block-pivots K: defer K tableau pivots and apply them together, default 0 for none\n");
+    printf("\t--tableau-dir DIR: keep the tableau in a file in DIR\n");
+    printf("\t--engine E: tableau (default) or revised simplex\n");
+    printf("\t--pivot-rule R: dantzig (default), steepest, devex, partial, multiple or bland\n");
+    printf("\t--precision P: tableau precision, double (default), float, mixed or exact\n");
+    printf("\t--presolve: remove dominated strategies first\n");
+    printf("\t--max-pivots N: stop each solve after N pivots, default 0 for no limit\n");
+    printf("\t--check: also solve each game with the double precision tableau and fail if the values differ\n");
+}
+
+/**
+ * Struct for storing the result of parsing command line arguments
+ *
+ * success: parsing of command line arguments was successful
+ * kinds: comma separated games to generate
+ * sizes: comma separated sizes to generate them at
+ * repeat: games of each kind and size
+ * seed: seed of the generated payoffs
+ * density: fraction of nonzero payoffs in sparse games
+ * check: compare every value with the double precision tableau
+ * options: options the games are solved with
+ */
+struct ArgResult {
+    bool success;
+    const char* kinds;
+    const char* sizes;
+    int repeat;
+    int seed;
+    double density;
+    bool check;
+    SolveOptions_t options;
+};
+typedef struct ArgResult ArgResult_t;
+
+/**
+ * Parses this program's command line arguments.
+ *
+ * argc: number of command line arguments
+ * argv: array of tokens
+ * result: filled with the parsed arguments
+ */
+void parse_args(int argc, char** argv, ArgResult_t* result) {
+    result->success = false;
+    result->kinds = DEFAULT_KINDS;
+    result->sizes = DEFAULT_SIZES;
+    result->repeat = 1;
+    result->seed = 1;
+    result->density = DEFAULT_DENSITY;
+    result->check = false;
+    default_solve_options(&result->options);
+
+    static struct option long_options[] = {
+        { "kinds", required_argument, NULL, 'K' },
+        { "sizes", required_argument, NULL, 'N' },
+        { "repeat", required_argument, NULL, 'R' },
+        { "seed", required_argument, NULL, 'S' },
+        { "density", required_argument, NULL, 'd' },
+        { "threads", required_argument, NULL, 't' },
+        { "block-pivots", required_argument, NULL, 'L' },
+        { "tableau-dir", required_argument, NULL, 'O' },
+        { "engine", required_argument, NULL, 'e' },
+        { "pivot-rule", required_argument, NULL, 'r' },
+        { "precision", required_argument, NULL, 'p' },
+        { "presolve", no_argument, NULL, 'D' },
+        { "max-pivots", required_argument, NULL, 'M' },
+        { "check", no_argument, NULL, 'C' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    int option;
+    char* check = NULL;
+    SolveOptions_t* options = &result->options;
+    while ((option = getopt_long(argc, argv, "", long_options, NULL)) != -1) {
+        switch (option) {
+            case 'K':
+                result->kinds = optarg;
+                break;
+            case 'N':
+                result->sizes = optarg;
+                break;
+            case 'R':
+                result->repeat = (int) strtol(optarg, &check, 10);
+                if (*check != '\0' || result->repeat < 1) return;
+                break;
+            case 'S':
+                result->seed = (int) strtol(optarg, &check, 10);
+                if (*check != '\0') return;
+                break;
+            case 'd':
+                result->density = strtod(optarg, &check);
+                if (*check != '\0' || !(result->density > 0 && result->density <= 1)) return;
+                break;
+            case 't':
+                options->threads = (int) strtol(optarg, &check, 10);
+                if (*check != '\0' || options->threads < 1) return;
+                break;
+            case 'L':
+                options->block_pivots = (int) strtol(optarg, &check, 10);
+                if (*check != '\0' || options->block_pivots < 0) return;
+                break;
+            case 'O':
+                options->tableau_dir = optarg;
+                break;
+            case 'e':
+                if (strcmp(optarg, "tableau") == 0) options->engine = ENGINE_TABLEAU;
+                else if (strcmp(optarg, "revised") == 0) options->engine = ENGINE_REVISED;
+                else return;
+                break;
+            case 'r':
+                if (strcmp(optarg, "dantzig") == 0) options->rule = RULE_DANTZIG;
+                else if (strcmp(optarg, "steepest") == 0) options->rule = RULE_STEEPEST_EDGE;
+                else if (strcmp(optarg, "devex") == 0) options->rule = RULE_DEVEX;
+                else if (strcmp(optarg, "partial") == 0) options->rule = RULE_PARTIAL;
+                else if (strcmp(optarg, "multiple") == 0) options->rule = RULE_MULTIPLE;
+                else if (strcmp(optarg, "bland") == 0) options->rule = RULE_BLAND;
+                else return;
+                break;
+            case 'p':
+                if (strcmp(optarg, "double") == 0) options->precision = PRECISION_DOUBLE;
+                else if (strcmp(optarg, "float") == 0) options->precision = PRECISION_FLOAT;
+                else if (strcmp(optarg, "mixed") == 0) options->precision = PRECISION_MIXED;
+                else if (strcmp(optarg, "exact") == 0) options->precision = PRECISION_EXACT;
+                else return;
+                break;
+            case 'D':
+                options->presolve = true;
+                break;
+            case 'M':
+                options->max_pivots = (int) strtol(optarg, &check, 10);
+                if (*check != '\0' || options->max_pivots < 0) return;
+                break;
+            case 'C':
+                result->check = true;
+                break;
+            default: // unknown option or missing argument
+                return;
+        }
+    }
+    result->success = argc == optind;
+}
+
+/**
+ * Draws the next number of a xorshift generator, so the games are the same
+ * on every platform
+ *
+ * state: state of the generator, not 0
+ *
+ * return: next number
+ */
+uint64_t next_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x * UINT64_C(0x2545F4914F6CDD1D);
+}
+
+/**
+ * Draws a uniform number in [0, 1)
+ *
+ * state: state of the generator
+ *
+ * return: next number
+ */
+double random_unit(uint64_t* state) {
+    return (double) (next_random(state) >> 11) / (double) (UINT64_C(1) << 53);
+}
+
+/**
+ * Struct for a generated game
+ *
+ * kind: name of the generator
+ * size: size it was generated at
+ * m: number of rows
+ * n: number of columns
+ * payoff: m by n payoff matrix, row-major
+ * sparse: solved from its nonzero entries
+ */
+struct BenchGame {
+    const char* kind;
+    int size;
+    int m;
+    int n;
+    double* payoff;
+    bool sparse;
+};
+typedef struct BenchGame BenchGame_t;
+
+/**
+ * Fills the payoff of a colonel blotto game. Each player splits the same
+ * number of soldiers over the battlefields, and wins a battlefield by
+ * sending more soldiers to it. Strategies are numbered by the soldiers sent
+ * to the first battlefield, then to the second.
+ *
+ * game: game to fill, its size sets the number of soldiers
+ */
+void generate_blotto(BenchGame_t* game) {
+    int soldiers = 0;
+    while ((soldiers + 2) * (soldiers + 1) / 2 < game->size) soldiers++;
+    int count = (soldiers + 2) * (soldiers + 1) / 2;
+
+    int* splits = (int*) malloc((size_t) count * BLOTTO_FIELDS * sizeof(int));
+    int index = 0;
+    for (int first = 0; first <= soldiers; first++) {
+        for (int second = 0; first + second <= soldiers; second++) {
+            splits[index * BLOTTO_FIELDS] = first;
+            splits[index * BLOTTO_FIELDS + 1] = second;
+            splits[index * BLOTTO_FIELDS + 2] = soldiers - first - second;
+            index++;
+        }
+    }
+
+    game->m = game->n = count;
+    game->payoff = (double*) malloc((size_t) count * count * sizeof(double));
+    for (int row = 0; row < count; row++) {
+        for (int col = 0; col < count; col++) {
+            int won = 0;
+            for (int field = 0; field < BLOTTO_FIELDS; field++) {
+                int mine = splits[row * BLOTTO_FIELDS + field];
+                int theirs = splits[col * BLOTTO_FIELDS + field];
+                won += (mine > theirs) - (mine < theirs);
+            }
+            game->payoff[(size_t) row * count + col] = won;
+        }
+    }
+    free(splits);
+}
+
+/**
+ * Fills the payoff of rock paper scissors with an odd number of throws,
+ * where each throw beats the half of the others that follow it
+ *
+ * game: game to fill, its size bounds the number of throws
+ */
+void generate_rpsls(BenchGame_t* game) {
+    int throws = (game->size % 2 == 1)? game->size : game->size - 1;
+    if (throws < 3) throws = 3;
+
+    game->m = game->n = throws;
+    game->payoff = (double*) malloc((size_t) throws * throws * sizeof(double));
+    for (int row = 0; row < throws; row++) {
+        for (int col = 0; col < throws; col++) {
+            int ahead = (col - row + throws) % throws;
+            game->payoff[(size_t) row * throws + col] = (ahead == 0)? 0 : (ahead <= throws / 2)? 1 : -1;
+        }
+    }
+}
+
+/**
+ * Fills the payoff of a game with uniform integer payoffs and a few more
+ * columns than rows
+ *
+ * game: game to fill, its size sets the number of rows
+ * state: state of the generator
+ */
+void generate_integer(BenchGame_t* game, uint64_t* state) {
+    game->m = game->size;
+    game->n = game->size + INTEGER_EXTRA_COLS;
+    game->payoff = (double*) malloc((size_t) game->m * game->n * sizeof(double));
+    for (size_t index = 0; index < (size_t) game->m * game->n; index++)
+        game->payoff[index] = (double) (next_random(state) % (2 * INTEGER_MAX_PAYOFF + 1)) - INTEGER_MAX_PAYOFF;
+}
+
+/**
+ * Generates a game
+ *
+ * kind: name of the generator
+ * size: number of rows and columns, roughly for the structured games
+ * density: fraction of nonzero payoffs in a sparse game
+ * state: state of the generator
+ * game: filled with the game, free its payoff
+ *
+ * return: if the kind is known
+ */
+bool generate_game(const char* kind, int size, double density, uint64_t* state, BenchGame_t* game) {
+    game->kind = kind;
+    game->size = size;
+    game->sparse = strcmp(kind, "sparse") == 0;
+
+    if (strcmp(kind, "blotto") == 0) generate_blotto(game);
+    else if (strcmp(kind, "rpsls") == 0) generate_rpsls(game);
+    else if (strcmp(kind, "integer") == 0) generate_integer(game, state);
+    else if (game->sparse || strcmp(kind, "dense") == 0 || strcmp(kind, "degenerate") == 0) {
+        bool degenerate = !game->sparse && strcmp(kind, "degenerate") == 0;
+        game->m = game->n = size;
+        game->payoff = (double*) malloc((size_t) size * size * sizeof(double));
+        for (size_t index = 0; index < (size_t) size * size; index++) {
+            double value = 2 * random_unit(state) - 1;
+            if (degenerate) value = (value >= 0);
+            else if (game->sparse && random_unit(state) >= density) value = 0;
+            game->payoff[index] = value;
+        }
+    }
+    else return false;
+    return true;
+}
+
+/**
+ * Struct for a growing text buffer
+ *
+ * data: text, not null terminated
+ * size: number of bytes of text
+ * capacity: number of bytes allocated
+ */
+struct Text {
+    char* data;
+    size_t size;
+    size_t capacity;
+};
+typedef struct Text Text_t;
+
+/**
+ * Appends a formatted number and a separator to a text buffer
+ *
+ * text: buffer to append to
+ * value: number to append, printed so it reads back exactly
+ * separator: character following the number
+ */
+void append_number(Text_t* text, double value, char separator) {
+    if (text->capacity - text->size < 32) {
+        text->capacity = 2 * text->capacity + 32;
+        text->data = (char*) realloc(text->data, text->capacity);
+    }
+    text->size += (size_t) snprintf(text->data + text->size, 32, "%.17g%c", value, separator);
+}
+
+/**
+ * Formats a game the way the simplex program reads it, dense rows or one
+ * "row column value" triple per nonzero entry
+ *
+ * game: game to format
+ * text: filled with the text
+ */
+void format_game(const BenchGame_t* game, Text_t* text) {
+    text->size = 0;
+    for (int row = 0; row < game->m; row++) {
+        for (int col = 0; col < game->n; col++) {
+            double value = game->payoff[(size_t) row * game->n + col];
+            if (!game->sparse) append_number(text, value, (col == game->n - 1)? '\n' : ' ');
+            else if (value != 0) {
+                append_number(text, row, ' ');
+                append_number(text, col, ' ');
+                append_number(text, value, '\n');
+            }
+        }
+    }
+}
+
+/**
+ * Struct for a parsed game, in the form the library solves it from
+ *
+ * payoff: m by n payoff matrix, row-major, NULL for a sparse game
+ * count: number of sparse entries
+ * rows: row of each sparse entry
+ * cols: column of each sparse entry
+ * values: value of each sparse entry
+ */
+struct ParsedGame {
+    double* payoff;
+    size_t count;
+    int* rows;
+    int* cols;
+    double* values;
+};
+typedef struct ParsedGame ParsedGame_t;
+
+/**
+ * Parses the text of a game with the parser of the simplex program
+ *
+ * game: game the text was formatted from
+ * text: text to parse
+ * parsed: filled with the game, free its buffers
+ *
+ * return: if the text parsed
+ */
+bool parse_game(const BenchGame_t* game, const Text_t* text, ParsedGame_t* parsed) {
+    memset(parsed, 0, sizeof(ParsedGame_t));
+    const char* cursor = text->data;
+    const char* end = text->data + text->size;
+
+    if (!game->sparse) {
+        parsed->payoff = (double*) malloc((size_t) game->m * game->n * sizeof(double));
+        for (int row = 0; row < game->m; row++) {
+            const char* line_end = find_line_end(cursor, end);
+            if (!parse_row(cursor, line_end, parsed->payoff + (size_t) row * game->n, game->n)) return false;
+            cursor = (line_end < end)? line_end + 1 : end;
+        }
+        return true;
+    }
+
+    size_t capacity = 0;
+    while (cursor < end) {
+        const char* line_end = find_line_end(cursor, end);
+        if (parsed->count == capacity) {
+            capacity = 2 * capacity + 64;
+            parsed->rows = (int*) realloc(parsed->rows, capacity * sizeof(int));
+            parsed->cols = (int*) realloc(parsed->cols, capacity * sizeof(int));
+            parsed->values = (double*) realloc(parsed->values, capacity * sizeof(double));
+        }
+
+        size_t entry = parsed->count;
+        bool valid = parse_index(&cursor, line_end, &parsed->rows[entry]);
+        cursor = skip_blanks(cursor, line_end);
+        valid = valid && parse_index(&cursor, line_end, &parsed->cols[entry]);
+        cursor = skip_blanks(cursor, line_end);
+        valid = valid && parse_number(&cursor, line_end, &parsed->values[entry]);
+        if (!valid) return false;
+        parsed->count++;
+        cursor = (line_end < end)? line_end + 1 : end;
+    }
+    return true;
+}
+
+/**
+ * Frees the buffers of a parsed game
+ *
+ * parsed: game to free
+ */
+void free_parsed_game(ParsedGame_t* parsed) {
+    free(parsed->payoff);
+    free(parsed->rows);
+    free(parsed->cols);
+    free(parsed->values);
+}
+
+/**
+ * Reads a clock that only moves forward
+ *
+ * return: seconds since some fixed point
+ */
+double monotonic_seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + 1e-9 * (double) now.tv_nsec;
+}
+
+/**
+ * Gets the largest resident set size of this process so far
+ *
+ * return: peak resident set size in kilobytes
+ */
+long peak_rss_kb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * Names a simplex implementation the way the command line does
+ *
+ * engine: implementation to name
+ *
+ * return: name
+ */
+const char* engine_name(Engine_t engine) {
+    return (engine == ENGINE_REVISED)? "revised" : "tableau";
+}
+
+/**
+ * Names a pivot rule the way the command line does
+ *
+ * rule: rule to name
+ *
+ * return: name
+ */
+const char* rule_name(PivotRule_t rule) {
+    static const char* names[] = { "dantzig", "steepest", "devex", "partial", "multiple", "bland" };
+    return names[rule];
+}
+
+/**
+ * Names a precision the way the command line does
+ *
+ * precision: precision to name
+ *
+ * return: name
+ */
+const char* precision_name(Precision_t precision) {
+    static const char* names[] = { "double", "float", "mixed", "exact" };
+    return names[precision];
+}
+
+/**
+ * Solves a generated game and prints its run as a JSON object. The
+ * elimination rate counts the 2 flops per entry of every row a tableau pivot
+ * eliminates, and is null for engines that do not pivot a whole tableau.
+ * A checked game is solved again with the double precision tableau, and
+ * the difference of the values is printed too.
+ *
+ * game: game to solve
+ * options: options to solve with
+ * workspace: buffers to solve in
+ * text: buffer for the text of the game
+ * repeat: index of the game among those of its kind and size
+ * first: first run printed
+ * check: compare the value with the double precision tableau
+ *
+ * return: if the game was solved, and agrees with the double precision
+ *         tableau when checked
+ */
+bool run_game(const BenchGame_t* game, const SolveOptions_t* options, Workspace_t* workspace, Text_t* text,
+              int repeat, bool first, bool check) {
+    format_game(game, text);
+    ParsedGame_t parsed;
+    double start = monotonic_seconds();
+    bool valid = parse_game(game, text, &parsed);
+    double parse_seconds = monotonic_seconds() - start;
+
+    SolveTimings_t timings;
+    SolveOptions_t timed = *options;
+    timed.timings = &timings;
+    double* p1 = (double*) malloc((size_t) game->m * sizeof(double));
+    double* p2 = (double*) malloc((size_t) game->n * sizeof(double));
+    SolveResult_t result = { .p1_strategy = p1, .p2_strategy = p2 };
+    bool solved = valid && ((game->sparse)?
+                  solve_sparse_game(workspace, game->m, game->n, parsed.count, parsed.rows, parsed.cols,
+                                    parsed.values, &timed, &result) :
+                  solve_dense_game(workspace, parsed.payoff, DTYPE_FLOAT64, game->m, game->n, &timed, &result));
+    if (!solved) memset(&timings, 0, sizeof(SolveTimings_t));
+
+    bool whole_tableau = options->engine == ENGINE_TABLEAU &&
+                         (options->precision == PRECISION_DOUBLE || options->precision == PRECISION_FLOAT);
+    int m = game->m - result.removed_rows;
+    int n = game->n - result.removed_cols;
+    double flops = 2.0 * m * (n + m + 1) * result.pivots;
+
+    printf("%s    {\"kind\": \"%s\", \"size\": %d, \"repeat\": %d, \"m\": %d, \"n\": %d, \"solved\": %s",
+           (first)? "" : ",\n", game->kind, game->size, repeat, game->m, game->n, (solved)? "true" : "false");
+    printf(", \"value\": %.9g, \"pivots\": %d", (solved)? result.value : 0, result.pivots);
+    printf(", \"parse_seconds\": %.9g, \"presolve_seconds\": %.9g, \"build_seconds\": %.9g", parse_seconds,
+           timings.presolve, timings.build);
+    printf(", \"pivot_seconds\": %.9g, \"slowest_pivot_seconds\": %.9g, \"extract_seconds\": %.9g", timings.pivot,
+           timings.slowest_pivot, timings.extract);
+    printf(", \"pivots_per_second\": %.9g", (timings.pivot > 0)? result.pivots / timings.pivot : 0);
+    if (whole_tableau && timings.pivot > 0) printf(", \"elimination_gflops\": %.9g", flops / timings.pivot * 1e-9);
+    else printf(", \"elimination_gflops\": null");
+    printf(", \"peak_rss_kb\": %ld", peak_rss_kb());
+
+    bool agrees = solved;
+    if (check) {
+        SolveOptions_t reference;
+        default_solve_options(&reference);
+        SolveResult_t expected = { .p1_strategy = p1, .p2_strategy = p2 };
+        bool reference_solved = solved &&
+                                solve_dense_game(workspace, game->payoff, DTYPE_FLOAT64, game->m, game->n, &reference, &expected);
+        double error = (reference_solved)? fabs(result.value - expected.value) : 0;
+        double tolerance = (options->precision == PRECISION_FLOAT)? FLOAT_CHECK_TOLERANCE : CHECK_TOLERANCE;
+        agrees = reference_solved && error <= tolerance;
+        if (reference_solved) printf(", \"value_error\": %.9g", error);
+        else printf(", \"value_error\": null");
+    }
+    printf("}");
+    fflush(stdout);
+
+    free(p1);
+    free(p2);
+    free_parsed_game(&parsed);
+    return agrees;
+}
+
+int main(int argc, char** argv) {
+    ArgResult_t args;
+    parse_args(argc, argv, &args);
+    if (!args.success) {
+        print_usage();
+        return 1;
+    }
+
+    // check the lists before printing anything
+    char* kinds = strdup(args.kinds);
+    char* sizes = strdup(args.sizes);
+    int size_count = 0;
+    int* size_list = (int*) malloc((strlen(sizes) / 2 + 1) * sizeof(int));
+    for (char* token = strtok(sizes, ","); token != NULL; token = strtok(NULL, ",")) {
+        char* check = NULL;
+        long size = strtol(token, &check, 10);
+        if (*check != '\0' || size < 1 || size > INT_MAX) {
+            print_usage();
+            return 1;
+        }
+        size_list[size_count++] = (int) size;
+    }
+
+    const SolveOptions_t* options = &args.options;
+    printf("{\n  \"engine\": \"%s\", \"pivot_rule\": \"%s\", \"precision\": \"%s\", \"threads\": %d, \"block_pivots\": %d,"
+           " \"out_of_core\": %s, \"presolve\": %s, \"seed\": %d,\n  \"runs\": [\n", engine_name(options->engine),
+           rule_name(options->rule), precision_name(options->precision), options->threads, options->block_pivots,
+           (options->tableau_dir != NULL)? "true" : "false", (options->presolve)? "true" : "false", args.seed);
+
+    Workspace_t* workspace = create_workspace();
+    Text_t text = { NULL, 0, 0 };
+    uint64_t state = UINT64_C(0x9E3779B97F4A7C15) ^ (uint64_t) args.seed;
+    if (state == 0) state = 1;
+    bool first = true;
+    bool failed = false;
+    int status = 0;
+    for (char* kind = strtok(kinds, ","); kind != NULL && status == 0; kind = strtok(NULL, ",")) {
+        for (int index = 0; index < size_count && status == 0; index++) {
+            for (int repeat = 0; repeat < args.repeat; repeat++) {
+                BenchGame_t game;
+                if (!generate_game(kind, size_list[index], args.density, &state, &game)) {
+                    fprintf(stderr, "Unknown game kind %s.\n", kind);
+                    status = 1;
+                    break;
+                }
+                if (!run_game(&game, options, workspace, &text, repeat, first, args.check) && args.check) {
+                    fprintf(stderr, "The %s game of size %d, repeat %d, does not match the double precision tableau.\n",
+                            kind, size_list[index], repeat);
+                    failed = true;
+                }
+                first = false;
+                free(game.payoff);
+            }
+        }
+    }
+    printf("\n  ]\n}\n");
+    if (failed) status = 1;
+
+    free_workspace(workspace);
+    free(text.data);
+    free(size_list);
+    free(kinds);
+    free(sizes);
+    return status;
+}
@@ -0,0 +1,7292 @@
+/**
+ * Author: Aidan Lynch
+ *
+ * libsimplex: runs the simplex method on a payoff matrix to find the optimal
+ * strategies and the value of the game
+ */
+
+// sync_file_range, which starts writing part of a file back, is Linux's own
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "simplex.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// tableau rows start on a cache line and are padded to a whole number of them
+#define TABLEAU_ALIGN 64
+#define TABLEAU_PAD (TABLEAU_ALIGN / (int) sizeof(double))
+#define FLOAT_TABLEAU_PAD (TABLEAU_ALIGN / (int) sizeof(float))
+
+// revised simplex pivots between refactorizations of the basis
+#define REFACTOR_INTERVAL 64
+// reduced costs above this are treated as zero by the revised simplex, since
+// it recomputes them from the basis and they are never exactly zero. by
+// default pivot column entries at most this cannot pivot, and right hand
+// sides down to minus this count as feasible, both in the ratio test and for
+// a start basis
+#define PRICE_TOLERANCE 1e-9
+#define PIVOT_TOLERANCE 1e-9
+#define FEASIBILITY_TOLERANCE 1e-9
+// a single precision tableau only trusts about six digits, so reduced costs,
+// pivot column entries and right hand sides this close to zero are treated
+// as zero, and the double precision check of its final basis allows this
+// much infeasibility
+#define FLOAT_PRICE_TOLERANCE 1e-6
+#define FLOAT_PIVOT_TOLERANCE 1e-6
+#define FLOAT_FEASIBILITY_TOLERANCE 1e-6
+#define MIXED_FEASIBILITY_TOLERANCE 1e-5
+// when rounding makes bland's rule revisit a basis of a single precision
+// tableau, its degenerate right hand sides are raised to between one and two
+// times this, which breaks the ties the pivots cycle through
+#define FLOAT_PERTURBATION 1e-5
+// the strategies of a mixed precision solve have to sum to 1 and guarantee
+// its value against every pure strategy to within this, the guarantees
+// relative to the largest payoff, or the double tableau solves it instead
+#define MIXED_VERIFY_TOLERANCE 1e-9
+// exact tableaus take integer payoffs up to this magnitude, so every entry
+// starts well inside 64 bits
+#define EXACT_MAX_PAYOFF 2147483648.0
+// exact entries widen to at most this many 64-bit limbs, which keeps them
+// within double range when they are converted, and pivots use this many
+// scratch values of that width
+#define EXACT_MAX_LIMBS 16
+#define EXACT_WORK_LIMBS 8
+
+// partial pricing scans this fraction of the columns at a time, but at least
+// the minimum, and multiple pricing keeps this many candidates
+#define PARTIAL_PRICING_SECTIONS 8
+#define PARTIAL_PRICING_MIN_WINDOW 16
+#define MULTIPLE_PRICING_CANDIDATES 4
+// the objective has to grow by this fraction of itself to count as progress.
+// long runs of degenerate pivots are common and usually end by themselves,
+// so Bland's rule only takes over once a run returns to a basis it already
+// visited, until the objective grows. single precision objectives move by
+// their rounding error on a degenerate pivot, so they need the larger one
+#define STALL_TOLERANCE 1e-12
+#define FLOAT_STALL_TOLERANCE 1e-6
+
+// under bland's rule only rows whose pivot column entry is at least this
+// fraction of the largest one tie by basic column in the ratio test, so a
+// row that barely clears the pivot tolerance is not taken for its index
+#define BLAND_PIVOT_FRACTION 1e-2
+
+// pivots skip the chunks of the other rows their pivot row is zero in when at
+// most this fraction of the chunks are left, and otherwise update whole rows
+// with fewer kernel calls
+#define SPAN_DENSITY 0.75
+
+// blocked pivots apply their deferred updates to tiles of columns whose
+// deferred pivot rows take this many entries together, sized to stay in the
+// L2 cache, and defer at most this many pivots
+#define BLOCK_TILE_ENTRIES 16384
+#define MAX_BLOCK_PIVOTS 64
+// a tableau kept in a file is pivoted in panels of rows taking about this
+// many bytes, the next one read ahead and the last one written back while
+// the current one is eliminated
+#define TABLEAU_PANEL_BYTES (64 << 20)
+// panels are only streamed once the file takes more than this fraction of
+// physical memory. a smaller one stays in the page cache and is left to the
+// kernel's writeback, since writing a panel back makes the next pivot fault
+// each of its pages writable again
+#define STREAM_MEMORY_FRACTION 0.5
+// result caches start with this many buckets and their files with this magic
+#define CACHE_BUCKETS 64
+#define CACHE_MAGIC "SXCACHE1"
+
+// statistics are only counted in a build with SIMPLEX_STATS, otherwise the
+// macros counting them compile to nothing
+#ifdef SIMPLEX_STATS
+// counters of the solve running on this thread, NULL outside of one
+static __thread SolveStats_t* stats;
+
+/**
+ * Reads a counter of clock cycles, or of nanoseconds where there is none
+ *
+ * return: count since some fixed point
+ */
+static inline uint64_t read_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t cycles;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(cycles));
+    return cycles;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+#endif
+}
+
+/**
+ * Counts the bytes of an allocation toward the solve running on this thread
+ *
+ * pointer: allocated block, NULL if the allocation failed
+ * size: bytes asked for
+ *
+ * return: pointer
+ */
+static inline void* count_allocation(void* pointer, size_t size) {
+    if (stats != NULL && pointer != NULL) stats->allocated_bytes += size;
+    return pointer;
+}
+
+// a macro is not expanded again inside itself, so these call the library
+#define malloc(size) count_allocation(malloc(size), (size))
+#define calloc(count, size) count_allocation(calloc(count, size), (size_t) (count) * (size))
+#define realloc(pointer, size) count_allocation(realloc(pointer, size), (size))
+#define aligned_alloc(align, size) count_allocation(aligned_alloc(align, size), (size))
+
+#define STATS_ADD(field, amount) do { if (stats != NULL) stats->field += (amount); } while (0)
+#define STATS_START(name) uint64_t name = read_cycles()
+#define STATS_CYCLES(field, name) STATS_ADD(field, read_cycles() - name)
+#else
+#define STATS_ADD(field, amount) ((void) 0)
+#define STATS_START(name) ((void) 0)
+#define STATS_CYCLES(field, name) ((void) 0)
+#endif
+
+// tableaus are printed through a local buffer of this many characters
+#define PRINT_BUFFER_SIZE 4096
+// a printed tableau cell never needs more than this many characters, since
+// DBL_MAX has 309 digits before the point
+#define CELL_SIZE (DBL_MAX_10_EXP + 8)
+
+/**
+ * Struct for storing a sparse matrix in compressed sparse column form
+ *
+ * m: number of rows
+ * n: number of columns
+ * nnz: number of stored entries
+ * col_start: index of the first entry of each column, n + 1 entries
+ * row_index: row of each entry, increasing within a column
+ * values: value of each entry, never zero
+ */
+struct SparseMatrix {
+    int m;
+    int n;
+    size_t nnz;
+    size_t* col_start;
+    int* row_index;
+    double* values;
+};
+typedef struct SparseMatrix SparseMatrix_t;
+
+/**
+ * Builds a sparse matrix from coordinate triples in any order. Repeated
+ * coordinates are summed and zeros are dropped.
+ *
+ * m: number of rows
+ * n: number of columns
+ * count: number of triples
+ * rows: row of each triple, in [0, m)
+ * cols: column of each triple, in [0, n)
+ * values: value of each triple
+ *
+ * return: sparse matrix
+ */
+SparseMatrix_t* create_sparse_matrix(int m, int n, size_t count, const int* rows, const int* cols, const double* values) {
+    SparseMatrix_t* matrix = (SparseMatrix_t*) malloc(sizeof(SparseMatrix_t));
+    matrix->m = m;
+    matrix->n = n;
+    matrix->col_start = (size_t*) calloc(n + 1, sizeof(size_t));
+    matrix->row_index = (int*) calloc(count, sizeof(int));
+    matrix->values = (double*) calloc(count, sizeof(double));
+
+    // bucket by row first so the stable second pass by column leaves rows sorted
+    size_t* row_start = (size_t*) calloc(m + 1, sizeof(size_t));
+    size_t* by_row = (size_t*) calloc(count, sizeof(size_t));
+    for (size_t entry = 0; entry < count; entry++) row_start[rows[entry] + 1]++;
+    for (int row = 0; row < m; row++) row_start[row + 1] += row_start[row];
+    for (size_t entry = 0; entry < count; entry++) by_row[row_start[rows[entry]]++] = entry;
+
+    size_t* next = (size_t*) calloc(n + 1, sizeof(size_t));
+    for (size_t entry = 0; entry < count; entry++) next[cols[entry] + 1]++;
+    for (int col = 0; col < n; col++) next[col + 1] += next[col];
+
+    size_t* by_col = (size_t*) calloc(count, sizeof(size_t));
+    for (size_t index = 0; index < count; index++) {
+        size_t entry = by_row[index];
+        by_col[next[cols[entry]]++] = entry;
+    }
+
+    // merge repeats and compact, next[col] now ends column col
+    size_t nnz = 0;
+    size_t start = 0;
+    for (int col = 0; col < n; col++) {
+        matrix->col_start[col] = nnz;
+        for (size_t index = start; index < next[col]; index++) {
+            size_t entry = by_col[index];
+            if (nnz > matrix->col_start[col] && matrix->row_index[nnz - 1] == rows[entry]) {
+                matrix->values[nnz - 1] += values[entry];
+            }
+            else {
+                matrix->row_index[nnz] = rows[entry];
+                matrix->values[nnz++] = values[entry];
+            }
+        }
+        start = next[col];
+
+        // drop entries that summed to zero
+        size_t kept = matrix->col_start[col];
+        for (size_t index = matrix->col_start[col]; index < nnz; index++) {
+            if (matrix->values[index] == 0) continue;
+            matrix->row_index[kept] = matrix->row_index[index];
+            matrix->values[kept++] = matrix->values[index];
+        }
+        nnz = kept;
+    }
+    matrix->col_start[n] = nnz;
+    matrix->nnz = nnz;
+
+    free(row_start);
+    free(by_row);
+    free(next);
+    free(by_col);
+    return matrix;
+}
+
+/**
+ * Frees a sparse matrix
+ *
+ * matrix: matrix to free
+ */
+void free_sparse_matrix(SparseMatrix_t* matrix) {
+    if (matrix != NULL) {
+        free(matrix->col_start);
+        free(matrix->row_index);
+        free(matrix->values);
+        free(matrix);
+    }
+}
+
+/**
+ * Reads an entry of a dense payoff matrix of either element type
+ *
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * index: row-major index of the entry
+ *
+ * return: the entry as a double
+ */
+static inline double payoff_entry(const void* payoff, Dtype_t dtype, size_t index) {
+    return (dtype == DTYPE_FLOAT64)? ((const double*) payoff)[index] : ((const float*) payoff)[index];
+}
+
+/**
+ * Converts a dense payoff matrix to sparse form, in two row-major passes so
+ * a mapped matrix is read in order
+ *
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * m: number of rows
+ * n: number of columns
+ *
+ * return: sparse matrix with the nonzero entries of payoff
+ */
+SparseMatrix_t* dense_to_sparse(const void* payoff, Dtype_t dtype, int m, int n) {
+    // count the nonzeros of each column
+    size_t* col_start = (size_t*) calloc(n + 1, sizeof(size_t));
+    for (int row = 0; row < m; row++) {
+        for (int col = 0; col < n; col++)
+            col_start[col + 1] += (payoff_entry(payoff, dtype, (size_t) row * n + col) != 0);
+    }
+    for (int col = 0; col < n; col++) col_start[col + 1] += col_start[col];
+
+    SparseMatrix_t* matrix = (SparseMatrix_t*) malloc(sizeof(SparseMatrix_t));
+    matrix->m = m;
+    matrix->n = n;
+    matrix->nnz = col_start[n];
+    matrix->col_start = col_start;
+    matrix->row_index = (int*) calloc(matrix->nnz, sizeof(int));
+    matrix->values = (double*) calloc(matrix->nnz, sizeof(double));
+
+    size_t* next = (size_t*) calloc(n, sizeof(size_t));
+    memcpy(next, col_start, n * sizeof(size_t));
+    for (int row = 0; row < m; row++) {
+        for (int col = 0; col < n; col++) {
+            double value = payoff_entry(payoff, dtype, (size_t) row * n + col);
+            if (value == 0) continue;
+            matrix->row_index[next[col]] = row;
+            matrix->values[next[col]++] = value;
+        }
+    }
+    free(next);
+
+    return matrix;
+}
+
+/**
+ * Expands a sparse matrix to a dense payoff matrix
+ *
+ * matrix: sparse matrix
+ *
+ * return: row-major payoff matrix of doubles, free with free
+ */
+double* sparse_to_dense(const SparseMatrix_t* matrix) {
+    double* payoff = (double*) calloc((size_t) matrix->m * matrix->n, sizeof(double));
+    for (int col = 0; col < matrix->n; col++) {
+        for (size_t index = matrix->col_start[col]; index < matrix->col_start[col + 1]; index++)
+            payoff[(size_t) matrix->row_index[index] * matrix->n + col] = matrix->values[index];
+    }
+    return payoff;
+}
+
+/**
+ * Finds the shift that makes every entry of a sparse payoff matrix at least 1,
+ * counting the implicit zeros
+ *
+ * matrix: sparse matrix
+ *
+ * return: amount to add to every payoff entry
+ */
+double sparse_shift(SparseMatrix_t* matrix) {
+    double min = ((long) matrix->m * matrix->n > (long) matrix->nnz)? 0 : DBL_MAX;
+    for (size_t index = 0; index < matrix->nnz; index++) {
+        if (matrix->values[index] < min) min = matrix->values[index];
+    }
+    return (min < 1)? 1 - min : 0;
+}
+
+
+/**
+ * Struct for storing a tableau
+ *
+ * m: matrix, row pointers into data
+ * data: row-major storage for m in a single aligned block
+ * stride: distance between rows in data, padded to TABLEAU_PAD
+ * s_size: length of S
+ * x_size: length of X
+ * rows: number of rows in m
+ * cols: number of columns in m
+ * k: amount added to every payoff entry
+ * pivot_tolerance: pivot column entries at most this cannot pivot
+ * feasibility_tolerance: right hand sides may go this far below zero
+ * capacity: number of doubles allocated for data
+ * row_capacity: number of row pointers allocated for m
+ * spans: runs of the pivot row the last pivot changed, see list_pivot_spans
+ * span_capacity: number of ints allocated for spans
+ * dir: directory to keep data in a file in, NULL to keep it in memory
+ * fd: descriptor of the file data is mapped from, -1 if it is in memory
+ * streamed: data is mapped and too large to stay in the page cache, so
+ *           pivots stream it a panel at a time
+ */
+struct Tableau {
+    double** m;
+    double* data;
+    size_t capacity;
+    int row_capacity;
+    int* spans;
+    int span_capacity;
+    const char* dir;
+    int fd;
+    bool streamed;
+    int stride;
+    int s_size;
+    int x_size;
+    int rows;
+    int cols;
+    double k;
+    double pivot_tolerance;
+    double feasibility_tolerance;
+};
+typedef struct Tableau Tableau_t;
+
+/**
+ * Gets a row of the tableau straight from its flat storage
+ *
+ * tableau: struct to index
+ * row: row index
+ *
+ * return: pointer to the first entry of the row
+ */
+static inline double* tableau_row(Tableau_t* tableau, int row) {
+    return tableau->data + (size_t) row * tableau->stride;
+}
+
+/**
+ * Checks whether a mapped tableau is too large to stay in the page cache
+ *
+ * capacity: number of doubles mapped
+ *
+ * return: true if pivots should stream it
+ */
+bool stream_tableau_file(size_t capacity) {
+    double memory = (double) sysconf(_SC_PHYS_PAGES) * (double) sysconf(_SC_PAGESIZE);
+    return (double) capacity * sizeof(double) > STREAM_MEMORY_FRACTION * memory;
+}
+
+/**
+ * Maps the storage of a tableau from a new file in its directory, which is
+ * removed straight away so its space is freed once the tableau lets go of
+ * it. The file is allocated up front, so a full disk shows up here rather
+ * than as a fault in the middle of a pivot, and it reads as zeros.
+ *
+ * tableau: struct to map the storage of, which must not have any
+ * capacity: number of doubles to map
+ *
+ * return: false if the file cannot be created, allocated or mapped, leaving
+ *         the tableau without storage
+ */
+bool map_tableau_file(Tableau_t* tableau, size_t capacity) {
+    size_t length = strlen(tableau->dir);
+    char* path = (char*) malloc(length + sizeof("/tableau-XXXXXX"));
+    memcpy(path, tableau->dir, length);
+    strcpy(path + length, "/tableau-XXXXXX");
+    int fd = mkstemp(path);
+    if (fd >= 0) unlink(path);
+    free(path);
+    if (fd < 0) return false;
+
+    size_t bytes = capacity * sizeof(double);
+    void* data = MAP_FAILED;
+    if (posix_fallocate(fd, 0, (off_t) bytes) == 0) data = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+
+    tableau->data = (double*) data;
+    tableau->capacity = capacity;
+    tableau->fd = fd;
+    tableau->streamed = stream_tableau_file(capacity);
+    return true;
+}
+
+/**
+ * Grows the file a tableau is kept in and maps it again, so every entry
+ * keeps its offset
+ *
+ * tableau: struct to grow the storage of, which must be mapped
+ * capacity: number of doubles to map
+ *
+ * return: false if the file cannot grow, leaving the tableau as it was
+ */
+bool grow_tableau_file(Tableau_t* tableau, size_t capacity) {
+    size_t bytes = capacity * sizeof(double);
+    if (posix_fallocate(tableau->fd, 0, (off_t) bytes) != 0) return false;
+    void* data = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, tableau->fd, 0);
+    if (data == MAP_FAILED) return false;
+
+    munmap(tableau->data, tableau->capacity * sizeof(double));
+    tableau->data = (double*) data;
+    tableau->capacity = capacity;
+    tableau->streamed = stream_tableau_file(capacity);
+    return true;
+}
+
+/**
+ * Frees the storage of a tableau, unmapping and closing its file if it is
+ * kept in one
+ *
+ * tableau: struct to free the storage of
+ */
+void release_tableau_data(Tableau_t* tableau) {
+    if (tableau->fd >= 0) {
+        munmap(tableau->data, tableau->capacity * sizeof(double));
+        close(tableau->fd);
+        tableau->fd = -1;
+        tableau->streamed = false;
+    }
+    else free(tableau->data);
+    tableau->data = NULL;
+    tableau->capacity = 0;
+}
+
+/**
+ * Reshapes a tableau and zeroes it, only reallocating its storage when the
+ * new shape does not fit in what it already has. A tableau with a directory
+ * is kept in a new file there instead, which is zero without writing it, and
+ * falls back to memory when the file cannot be made.
+ *
+ * tableau: struct to reshape
+ * s_size: length of S
+ * x_size: length of X
+ */
+void reset_tableau(Tableau_t* tableau, int s_size, int x_size) {
+    tableau->s_size = s_size;
+    tableau->x_size = x_size;
+    tableau->rows = s_size + 1;
+    tableau->cols = x_size + s_size + 1;
+    tableau->k = 0;
+
+    // round the row length up so every row starts on an aligned boundary
+    tableau->stride = (tableau->cols + TABLEAU_PAD - 1) / TABLEAU_PAD * TABLEAU_PAD;
+    size_t size = (size_t) tableau->rows * tableau->stride;
+    if (tableau->fd >= 0 || tableau->dir != NULL || size > tableau->capacity) release_tableau_data(tableau);
+    if (tableau->data == NULL && tableau->dir != NULL) map_tableau_file(tableau, size);
+    if (tableau->data == NULL) {
+        tableau->data = (double*) aligned_alloc(TABLEAU_ALIGN, size * sizeof(double));
+        tableau->capacity = size;
+    }
+    if (tableau->fd < 0) memset(tableau->data, 0, size * sizeof(double));
+
+    if (tableau->rows > tableau->row_capacity) {
+        free(tableau->m);
+        tableau->m = (double**) calloc(tableau->rows, sizeof(double*));
+        tableau->row_capacity = tableau->rows;
+    }
+    for (int row = 0; row < tableau->rows; row++)
+        tableau->m[row] = tableau_row(tableau, row);
+}
+
+/**
+ * Initialize a new tableau
+ *
+ * s_size: length of S
+ * x_size: length of X
+ */
+Tableau_t* create_tableau(int s_size, int x_size) {
+    Tableau_t* tableau = (Tableau_t*) malloc(sizeof(Tableau_t));
+    tableau->m = NULL;
+    tableau->data = NULL;
+    tableau->capacity = 0;
+    tableau->row_capacity = 0;
+    tableau->spans = NULL;
+    tableau->span_capacity = 0;
+    tableau->dir = NULL;
+    tableau->fd = -1;
+    tableau->streamed = false;
+    tableau->pivot_tolerance = PIVOT_TOLERANCE;
+    tableau->feasibility_tolerance = FEASIBILITY_TOLERANCE;
+    reset_tableau(tableau, s_size, x_size);
+    return tableau;
+}
+
+/**
+ * Frees a tableau struct
+ *
+ * tableau: struct to free
+ */
+void free_tableau(Tableau_t* tableau) {
+    free(tableau->spans);
+    free(tableau->m);
+    release_tableau_data(tableau);
+    free(tableau);
+}
+
+/**
+ * Writes a number the way printf's "%6.2f" does, without parsing a format.
+ * Values that are huge or close to a rounding tie go through snprintf, so the
+ * output matches it exactly.
+ *
+ * out: buffer of at least CELL_SIZE characters
+ * value: number to write
+ *
+ * return: number of characters written
+ */
+int format_cell(char* out, double value) {
+    double scaled = value * 100;
+    double rounded = nearbyint(scaled);
+    if (!(fabs(scaled) < 1e9) || fabs(fabs(scaled - rounded) - 0.5) < 1e-6)
+        return snprintf(out, CELL_SIZE, "%6.2f", value);
+
+    // build the digits backwards, with at least one before the point
+    char digits[CELL_SIZE];
+    int length = 0;
+    long long number = llabs((long long) rounded);
+    do {
+        digits[length++] = (char) ('0' + number % 10);
+        number /= 10;
+        if (length == 2) digits[length++] = '.';
+    } while (number > 0 || length < 4);
+    if (signbit(value)) digits[length++] = '-';
+
+    int size = 0;
+    for (int pad = length; pad < 6; pad++) out[size++] = ' ';
+    while (length > 0) out[size++] = digits[--length];
+    return size;
+}
+
+/**
+ * Gets an entry of a tableau of some element type, in double precision
+ *
+ * context: tableau to read
+ * row: row index
+ * col: column index
+ *
+ * return: entry
+ */
+typedef double (*CellFn)(void* context, int row, int col);
+
+/**
+ * Prints a tableau matrix of any element type
+ *
+ * stream: where to print
+ * cell: gets the entries of the tableau
+ * context: passed to cell
+ * s_size: length of S
+ * x_size: length of X
+ * rows: number of rows
+ * cols: number of columns
+ */
+static void print_cells(FILE* stream, CellFn cell, void* context, int s_size, int x_size, int rows, int cols) {
+    char buffer[PRINT_BUFFER_SIZE];
+    int used = 0;
+
+    for (int row = 0; row < rows; row++) {
+        if (row == s_size) { // divider, as long as a row
+            for (int count = 7 * cols + 2; count > 0; count--) {
+                if (used >= PRINT_BUFFER_SIZE - 1) {
+                    fwrite(buffer, 1, used, stream);
+                    used = 0;
+                }
+                buffer[used++] = '-';
+            }
+            buffer[used++] = '\n';
+        }
+
+        for (int col = 0; col < cols; col++) {
+            if (used > PRINT_BUFFER_SIZE - CELL_SIZE - 3) {
+                fwrite(buffer, 1, used, stream);
+                used = 0;
+            }
+            if (col == x_size || col == x_size + s_size) buffer[used++] = '|';
+            used += format_cell(buffer + used, cell(context, row, col));
+            buffer[used++] = ' ';
+        }
+        buffer[used++] = '\n';
+    }
+
+    fwrite(buffer, 1, used, stream);
+}
+
+/**
+ * Gets an entry of a tableau for print_cells
+ */
+static double tableau_cell(void* context, int row, int col) {
+    Tableau_t* tableau = (Tableau_t*) context;
+    return tableau->m[row][col];
+}
+
+/**
+ * Prints the tableau matrix
+ *
+ * stream: where to print
+ * tableau: struct to print
+ */
+void print_tableau(FILE* stream, Tableau_t* tableau) {
+    print_cells(stream, tableau_cell, tableau, tableau->s_size, tableau->x_size, tableau->rows, tableau->cols);
+}
+
+
+/**
+ * Finds the shift that makes every payoff entry at least 1, so the value of
+ * the shifted game is positive
+ *
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * m: number of rows
+ * n: number of columns
+ *
+ * return: amount to add to every payoff entry
+ */
+double payoff_shift(const void* payoff, Dtype_t dtype, int m, int n) {
+    // find minimum payoff value
+    size_t size = (size_t) m * n;
+    double min = DBL_MAX;
+    if (dtype == DTYPE_FLOAT64) {
+        const double* values = (const double*) payoff;
+        for (size_t index = 0; index < size; index++) min = fmin(min, values[index]);
+    }
+    else {
+        const float* values = (const float*) payoff;
+        for (size_t index = 0; index < size; index++) min = fmin(min, values[index]);
+    }
+    return (min < 1)? 1 - min : 0;
+}
+
+/**
+ * Fills a freshly reset tableau with the initial tableau of a payoff matrix,
+ * reading each payoff row once after the shift is known
+ *
+ * tableau: zeroed struct of s_size m and x_size n to fill
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * m: number of rows
+ * n: number of columns
+ */
+void load_init_tableau(Tableau_t* tableau, const void* payoff, Dtype_t dtype, int m, int n) {
+    double k = payoff_shift(payoff, dtype, m, n);
+    tableau->k = k;
+
+    // the tableau starts zeroed, so only the nonzero entries are written
+    for (int row = 0; row < m; row++) {
+        double* tableau_row = tableau->m[row];
+        if (dtype == DTYPE_FLOAT64) {
+            const double* values = (const double*) payoff + (size_t) row * n;
+            for (int col = 0; col < n; col++) tableau_row[col] = values[col] + k;
+        }
+        else {
+            const float* values = (const float*) payoff + (size_t) row * n;
+            for (int col = 0; col < n; col++) tableau_row[col] = (double) values[col] + k;
+        }
+        tableau_row[n + row] = 1;
+        tableau_row[tableau->cols - 1] = 1;
+    }
+    for (int col = 0; col < n; col++) tableau->m[m][col] = -1;
+}
+
+/**
+ * Grows a tableau to a larger shape, keeping every entry at the same row and
+ * column and zeroing the new ones. Rows only move when the stride grows, and
+ * storage is only reallocated when the new shape no longer fits, by at least
+ * half again so a run of appends reallocates rarely. A tableau kept in a file
+ * grows the file in place instead, by just what the new shape needs.
+ *
+ * tableau: struct to grow
+ * rows: new number of rows, at least the current one
+ * cols: new number of columns, at least the current one
+ */
+void grow_tableau(Tableau_t* tableau, int rows, int cols) {
+    int old_rows = tableau->rows;
+    int old_cols = tableau->cols;
+    size_t old_stride = tableau->stride;
+    size_t stride = (cols + TABLEAU_PAD - 1) / TABLEAU_PAD * TABLEAU_PAD;
+    size_t size = (size_t) rows * stride;
+
+    if (size > tableau->capacity && !(tableau->fd >= 0 && grow_tableau_file(tableau, size))) {
+        size_t capacity = tableau->capacity + tableau->capacity / 2;
+        if (capacity < size) capacity = size;
+        capacity = (capacity + TABLEAU_PAD - 1) / TABLEAU_PAD * TABLEAU_PAD;
+
+        double* data = (double*) aligned_alloc(TABLEAU_ALIGN, capacity * sizeof(double));
+        memset(data, 0, size * sizeof(double));
+        for (int row = 0; row < old_rows; row++)
+            memcpy(data + row * stride, tableau->data + row * old_stride, old_cols * sizeof(double));
+        release_tableau_data(tableau);
+        tableau->data = data;
+        tableau->capacity = capacity;
+    }
+    else {
+        // rows only move towards the end, so move the last one first
+        for (int row = old_rows - 1; row >= 0 && stride != old_stride; row--) {
+            memmove(tableau->data + row * stride, tableau->data + row * old_stride, old_cols * sizeof(double));
+            memset(tableau->data + row * stride + old_cols, 0, (stride - old_cols) * sizeof(double));
+        }
+        memset(tableau->data + old_rows * stride, 0, (rows - old_rows) * stride * sizeof(double));
+    }
+
+    tableau->stride = stride;
+    tableau->rows = rows;
+    tableau->cols = cols;
+
+    if (rows > tableau->row_capacity) {
+        free(tableau->m);
+        tableau->m = (double**) calloc(rows, sizeof(double*));
+        tableau->row_capacity = rows;
+    }
+    for (int row = 0; row < rows; row++)
+        tableau->m[row] = tableau_row(tableau, row);
+}
+
+/**
+ * Counts the rows in each panel a tableau kept in a file is pivoted in
+ *
+ * tableau: struct to count the panel rows of
+ *
+ * return: rows per panel, at least one
+ */
+static inline int tableau_panel_rows(Tableau_t* tableau) {
+    size_t rows = TABLEAU_PANEL_BYTES / ((size_t) tableau->stride * sizeof(double));
+    return (rows > 0)? (int) rows : 1;
+}
+
+/**
+ * Asks the kernel to start reading some rows of a tableau kept in a file
+ *
+ * tableau: struct to read the rows of
+ * start: first row to read
+ * end: one past the last row to read
+ */
+void read_ahead_tableau_rows(Tableau_t* tableau, int start, int end) {
+    if (start >= end) return;
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    size_t first = (size_t) start * tableau->stride * sizeof(double) / page * page;
+    size_t last = (size_t) end * tableau->stride * sizeof(double);
+    madvise((char*) tableau->data + first, last - first, MADV_WILLNEED);
+}
+
+/**
+ * Asks the kernel to start writing some rows of a tableau kept in a file
+ * back to it, without waiting for the writes
+ *
+ * tableau: struct to write the rows of
+ * start: first row to write
+ * end: one past the last row to write
+ */
+void write_back_tableau_rows(Tableau_t* tableau, int start, int end) {
+    if (start >= end) return;
+    size_t first = (size_t) start * tableau->stride * sizeof(double);
+    size_t last = (size_t) end * tableau->stride * sizeof(double);
+#ifdef __linux__
+    sync_file_range(tableau->fd, (off_t) first, (off_t) (last - first), SYNC_FILE_RANGE_WRITE);
+#else
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    first = first / page * page;
+    msync((char*) tableau->data + first, last - first, MS_ASYNC);
+#endif
+}
+
+/**
+ * Streams the panels of a tableau kept in a file while a pivot walks its
+ * rows in order. At the first row of each panel the next one is read ahead
+ * and the previous one is written back, so the disk works while the panel
+ * is eliminated. A tableau that is not streamed is left alone.
+ *
+ * tableau: struct being pivoted
+ * row: row the pivot is at
+ * start: first row the pivot walks
+ * end: one past the last row the pivot walks
+ */
+static inline void stream_tableau_panel(Tableau_t* tableau, int row, int start, int end) {
+    if (!tableau->streamed) return;
+    int panel = tableau_panel_rows(tableau);
+    if ((row - start) % panel != 0) return;
+
+    int ahead_end = (end - row > 2 * panel)? row + 2 * panel : end;
+    read_ahead_tableau_rows(tableau, (row == start)? row : row + panel, ahead_end);
+    write_back_tableau_rows(tableau, (row - start > panel)? row - panel : start, row);
+}
+
+
+/**
+ * Struct for a tableau stored in single precision, with the same layout as
+ * Tableau_t. Each pivot streams half the bytes of a double tableau through
+ * memory, and a vector register holds twice as many entries.
+ *
+ * data: rows of the tableau, each TABLEAU_ALIGN aligned
+ * stride: distance between rows in data, padded to FLOAT_TABLEAU_PAD
+ * s_size: length of S
+ * x_size: length of X
+ * rows: number of rows
+ * cols: number of columns
+ * k: amount added to every payoff entry
+ * pivot_tolerance: pivot column entries at most this cannot pivot
+ * feasibility_tolerance: right hand sides may go this far below zero
+ * capacity: number of floats allocated for data
+ * spans: runs of the pivot row the last pivot changed, see list_pivot_spans
+ * span_capacity: number of ints allocated for spans
+ */
+struct FloatTableau {
+    float* data;
+    size_t capacity;
+    int* spans;
+    int span_capacity;
+    int stride;
+    int s_size;
+    int x_size;
+    int rows;
+    int cols;
+    double k;
+    double pivot_tolerance;
+    double feasibility_tolerance;
+};
+typedef struct FloatTableau FloatTableau_t;
+
+/**
+ * Gets a row of a single precision tableau
+ *
+ * tableau: struct to index
+ * row: row index
+ *
+ * return: pointer to the first entry of the row
+ */
+static inline float* float_tableau_row(FloatTableau_t* tableau, int row) {
+    return tableau->data + (size_t) row * tableau->stride;
+}
+
+/**
+ * Reshapes a single precision tableau and zeroes it, like reset_tableau
+ *
+ * tableau: struct to reshape
+ * s_size: length of S
+ * x_size: length of X
+ */
+void reset_float_tableau(FloatTableau_t* tableau, int s_size, int x_size) {
+    tableau->s_size = s_size;
+    tableau->x_size = x_size;
+    tableau->rows = s_size + 1;
+    tableau->cols = x_size + s_size + 1;
+    tableau->k = 0;
+
+    tableau->stride = (tableau->cols + FLOAT_TABLEAU_PAD - 1) / FLOAT_TABLEAU_PAD * FLOAT_TABLEAU_PAD;
+    size_t size = (size_t) tableau->rows * tableau->stride;
+    if (size > tableau->capacity) {
+        free(tableau->data);
+        tableau->data = (float*) aligned_alloc(TABLEAU_ALIGN, size * sizeof(float));
+        tableau->capacity = size;
+    }
+    memset(tableau->data, 0, size * sizeof(float));
+}
+
+/**
+ * Initialize a new single precision tableau
+ *
+ * s_size: length of S
+ * x_size: length of X
+ */
+FloatTableau_t* create_float_tableau(int s_size, int x_size) {
+    FloatTableau_t* tableau = (FloatTableau_t*) malloc(sizeof(FloatTableau_t));
+    tableau->data = NULL;
+    tableau->capacity = 0;
+    tableau->spans = NULL;
+    tableau->span_capacity = 0;
+    tableau->pivot_tolerance = FLOAT_PIVOT_TOLERANCE;
+    tableau->feasibility_tolerance = FLOAT_FEASIBILITY_TOLERANCE;
+    reset_float_tableau(tableau, s_size, x_size);
+    return tableau;
+}
+
+/**
+ * Frees a single precision tableau struct
+ *
+ * tableau: struct to free
+ */
+void free_float_tableau(FloatTableau_t* tableau) {
+    free(tableau->spans);
+    free(tableau->data);
+    free(tableau);
+}
+
+/**
+ * Gets an entry of a single precision tableau for print_cells
+ */
+static double float_tableau_cell(void* context, int row, int col) {
+    FloatTableau_t* tableau = (FloatTableau_t*) context;
+    return float_tableau_row(tableau, row)[col];
+}
+
+/**
+ * Prints a single precision tableau matrix the same way as print_tableau
+ *
+ * stream: where to print
+ * tableau: struct to print
+ */
+void print_float_tableau(FILE* stream, FloatTableau_t* tableau) {
+    print_cells(stream, float_tableau_cell, tableau, tableau->s_size, tableau->x_size, tableau->rows, tableau->cols);
+}
+
+/**
+ * Fills a freshly reset single precision tableau with the initial tableau of
+ * a payoff matrix. The shift is added in double precision before rounding.
+ *
+ * tableau: zeroed struct of s_size m and x_size n to fill
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * m: number of rows
+ * n: number of columns
+ */
+void load_float_tableau(FloatTableau_t* tableau, const void* payoff, Dtype_t dtype, int m, int n) {
+    double k = payoff_shift(payoff, dtype, m, n);
+    tableau->k = k;
+
+    for (int row = 0; row < m; row++) {
+        float* tableau_row = float_tableau_row(tableau, row);
+        if (dtype == DTYPE_FLOAT64) {
+            const double* values = (const double*) payoff + (size_t) row * n;
+            for (int col = 0; col < n; col++) tableau_row[col] = (float) (values[col] + k);
+        }
+        else {
+            const float* values = (const float*) payoff + (size_t) row * n;
+            for (int col = 0; col < n; col++) tableau_row[col] = (float) ((double) values[col] + k);
+        }
+        tableau_row[n + row] = 1;
+        tableau_row[tableau->cols - 1] = 1;
+    }
+
+    float* objective_row = float_tableau_row(tableau, m);
+    for (int col = 0; col < n; col++) objective_row[col] = -1;
+}
+
+
+/**
+ * Fixed width integers for the exact tableau, stored as 64-bit limbs from
+ * least significant up in two's complement. Every value in one tableau has
+ * the same number of limbs, so rows stay flat arrays. Arithmetic wraps
+ * modulo 2^(64 * limbs), which the exact tableau relies on: its entries are
+ * known to fit, so their low bits are all that is needed.
+ */
+
+/**
+ * Sets a wide integer to a 64-bit value
+ *
+ * out: limbs to set
+ * value: value to store
+ * limbs: number of limbs
+ */
+static void limbs_from_int64(uint64_t* out, int64_t value, int limbs) {
+    out[0] = (uint64_t) value;
+    for (int limb = 1; limb < limbs; limb++) out[limb] = (value < 0)? UINT64_MAX : 0;
+}
+
+/**
+ * Copies a wide integer into one with at least as many limbs, keeping its
+ * value
+ *
+ * out: limbs to set, out_limbs of them
+ * out_limbs: number of limbs of out
+ * in: limbs to copy, in_limbs of them
+ * in_limbs: number of limbs of in
+ */
+static void limbs_extend(uint64_t* out, int out_limbs, const uint64_t* in, int in_limbs) {
+    memcpy(out, in, in_limbs * sizeof(uint64_t));
+    uint64_t fill = (in[in_limbs - 1] >> 63)? UINT64_MAX : 0;
+    for (int limb = in_limbs; limb < out_limbs; limb++) out[limb] = fill;
+}
+
+/**
+ * Checks the sign of a wide integer
+ */
+static inline bool limbs_negative(const uint64_t* a, int limbs) {
+    return a[limbs - 1] >> 63;
+}
+
+/**
+ * Checks if a wide integer is zero
+ */
+static bool limbs_zero(const uint64_t* a, int limbs) {
+    for (int limb = 0; limb < limbs; limb++) {
+        if (a[limb] != 0) return false;
+    }
+    return true;
+}
+
+/**
+ * Negates a wide integer in place
+ */
+static void limbs_negate(uint64_t* a, int limbs) {
+    uint64_t carry = 1;
+    for (int limb = 0; limb < limbs; limb++) {
+        a[limb] = ~a[limb] + carry;
+        carry = carry && a[limb] == 0;
+    }
+}
+
+/**
+ * Compares two wide integers of the same width
+ *
+ * return: negative, zero or positive as a is below, equal to or above b
+ */
+static int limbs_compare(const uint64_t* a, const uint64_t* b, int limbs) {
+    bool a_negative = limbs_negative(a, limbs);
+    if (a_negative != limbs_negative(b, limbs)) return (a_negative)? -1 : 1;
+    for (int limb = limbs - 1; limb >= 0; limb--) {
+        if (a[limb] != b[limb]) return (a[limb] < b[limb])? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * Multiplies two wide integers, keeping the low limbs of the product
+ *
+ * out: set to a * b modulo 2^(64 * limbs), must not alias a or b
+ * a: first factor
+ * b: second factor
+ * limbs: number of limbs
+ */
+static void limbs_multiply(uint64_t* restrict out, const uint64_t* a, const uint64_t* b, int limbs) {
+    memset(out, 0, limbs * sizeof(uint64_t));
+    for (int i = 0; i < limbs; i++) {
+        if (a[i] == 0) continue;
+
+        uint64_t carry = 0;
+        for (int j = 0; j + i < limbs; j++) {
+            unsigned __int128 product = (unsigned __int128) a[i] * b[j] + out[i + j] + carry;
+            out[i + j] = (uint64_t) product;
+            carry = (uint64_t) (product >> 64);
+        }
+    }
+}
+
+/**
+ * Multiplies two nonnegative wide integers into a product twice as wide
+ *
+ * out: set to a * b, 2 * limbs limbs, must not alias a or b
+ * a: first factor, nonnegative
+ * b: second factor, nonnegative
+ * limbs: number of limbs of a and b
+ */
+static void limbs_multiply_full(uint64_t* restrict out, const uint64_t* a, const uint64_t* b, int limbs) {
+    memset(out, 0, 2 * limbs * sizeof(uint64_t));
+    for (int i = 0; i < limbs; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; j < limbs; j++) {
+            unsigned __int128 product = (unsigned __int128) a[i] * b[j] + out[i + j] + carry;
+            out[i + j] = (uint64_t) product;
+            carry = (uint64_t) (product >> 64);
+        }
+        out[i + limbs] = carry;
+    }
+}
+
+/**
+ * Subtracts one wide integer from another in place
+ *
+ * a: set to a - b modulo 2^(64 * limbs)
+ * b: amount to subtract
+ * limbs: number of limbs
+ */
+static void limbs_subtract(uint64_t* a, const uint64_t* b, int limbs) {
+    uint64_t borrow = 0;
+    for (int limb = 0; limb < limbs; limb++) {
+        uint64_t difference = a[limb] - b[limb] - borrow;
+        borrow = (a[limb] < b[limb]) || (a[limb] == b[limb] && borrow);
+        a[limb] = difference;
+    }
+}
+
+/**
+ * Counts the trailing zero bits of a nonzero wide integer
+ */
+static int limbs_trailing_zeros(const uint64_t* a, int limbs) {
+    int limb = 0;
+    while (limb < limbs - 1 && a[limb] == 0) limb++;
+    return 64 * limb + __builtin_ctzll(a[limb]);
+}
+
+/**
+ * Shifts a wide integer right, filling with zeros
+ *
+ * a: integer to shift in place
+ * shift: number of bits, below 64 * limbs
+ * limbs: number of limbs
+ */
+static void limbs_shift_right(uint64_t* a, int shift, int limbs) {
+    int whole = shift / 64;
+    int bits = shift % 64;
+    for (int limb = 0; limb < limbs; limb++) {
+        uint64_t low = (limb + whole < limbs)? a[limb + whole] : 0;
+        uint64_t high = (limb + whole + 1 < limbs)? a[limb + whole + 1] : 0;
+        a[limb] = (bits == 0)? low : (low >> bits) | (high << (64 - bits));
+    }
+}
+
+/**
+ * Sign extends the low bits of a wide integer over the rest of it
+ *
+ * a: integer to extend in place
+ * bits: number of low bits holding the value, at least 1
+ * limbs: number of limbs
+ */
+static void limbs_sign_extend(uint64_t* a, int bits, int limbs) {
+    int limb = (bits - 1) / 64;
+    int offset = (bits - 1) % 64;
+    bool negative = (a[limb] >> offset) & 1;
+    uint64_t mask = (offset == 63)? UINT64_MAX : ((uint64_t) 1 << (offset + 1)) - 1;
+    a[limb] = (negative)? a[limb] | ~mask : a[limb] & mask;
+    for (limb++; limb < limbs; limb++) a[limb] = (negative)? UINT64_MAX : 0;
+}
+
+/**
+ * Finds the inverse of an odd 64-bit integer modulo 2^64 with Newton's
+ * iteration, each step of which doubles the number of correct low bits
+ */
+static uint64_t inverse_uint64(uint64_t odd) {
+    uint64_t inverse = odd; // correct to 3 bits, since odd * odd is 1 mod 8
+    for (int step = 0; step < 5; step++) inverse *= 2 - odd * inverse;
+    return inverse;
+}
+
+/**
+ * Finds the inverse of an odd wide integer modulo 2^(64 * limbs) with
+ * Newton's iteration
+ *
+ * out: set to the inverse
+ * odd: odd integer to invert
+ * work: scratch space of 2 * limbs limbs
+ * limbs: number of limbs
+ */
+static void limbs_inverse(uint64_t* restrict out, const uint64_t* odd, uint64_t* restrict work, int limbs) {
+    uint64_t* product = work;
+    uint64_t* next = work + limbs;
+    limbs_from_int64(out, 0, limbs);
+    out[0] = inverse_uint64(odd[0]);
+
+    for (int bits = 64; bits < 64 * limbs; bits *= 2) {
+        // out = out * (2 - odd * out)
+        limbs_multiply(product, odd, out, limbs);
+        limbs_negate(product, limbs);
+        uint64_t carry = 2;
+        for (int limb = 0; limb < limbs && carry != 0; limb++) {
+            product[limb] += carry;
+            carry = product[limb] < carry;
+        }
+        limbs_multiply(next, out, product, limbs);
+        memcpy(out, next, limbs * sizeof(uint64_t));
+    }
+}
+
+/**
+ * Splits the magnitude of a wide integer into a mantissa and a power of two
+ *
+ * a: integer to split
+ * limbs: number of limbs
+ * exponent: set so that |a| is about the mantissa times 2^exponent
+ *
+ * return: mantissa, 0 when a is zero
+ */
+static double limbs_mantissa(const uint64_t* a, int limbs, int* exponent) {
+    bool negative = limbs_negative(a, limbs);
+    double mantissa = 0;
+    int top = -1;
+    for (int limb = limbs - 1; limb >= 0; limb--) {
+        uint64_t value = (negative)? ~a[limb] : a[limb];
+        if (top < 0 && value == 0) continue;
+        if (top < 0) top = limb;
+        if (top - limb >= 3) break;
+        mantissa += ldexp((double) value, 64 * (limb - top));
+    }
+
+    // -a is ~a + 1, and the +1 only matters for small values
+    if (negative) mantissa = (top < 0)? 1 : mantissa + ((top == 0)? 1 : 0);
+    *exponent = 64 * ((top < 0)? 0 : top);
+    return mantissa;
+}
+
+/**
+ * Divides two wide integers into the nearest double, without overflowing
+ * when both are huge
+ *
+ * a: numerator
+ * b: denominator, not zero
+ * limbs: number of limbs
+ *
+ * return: a / b, 0 only when a is zero
+ */
+static double limbs_ratio(const uint64_t* a, const uint64_t* b, int limbs) {
+    int a_exponent, b_exponent;
+    double a_mantissa = limbs_mantissa(a, limbs, &a_exponent);
+    double b_mantissa = limbs_mantissa(b, limbs, &b_exponent);
+    double ratio = ldexp(a_mantissa / b_mantissa, a_exponent - b_exponent);
+    return (limbs_negative(a, limbs) != limbs_negative(b, limbs))? -ratio : ratio;
+}
+
+/**
+ * Gets a wide integer as a 128-bit one, if it fits
+ *
+ * a: integer to convert
+ * limbs: number of limbs
+ * out: set to the value
+ *
+ * return: if the value fits in 128 bits
+ */
+static bool limbs_to_int128(const uint64_t* a, int limbs, __int128* out) {
+    uint64_t fill = (limbs_negative(a, limbs))? UINT64_MAX : 0;
+    for (int limb = 2; limb < limbs; limb++) {
+        if (a[limb] != fill) return false;
+    }
+    if (limbs > 1 && (a[1] >> 63) != (fill >> 63)) return false;
+
+    uint64_t high = (limbs > 1)? a[1] : fill;
+    *out = (__int128) (((unsigned __int128) high << 64) | a[0]);
+    return true;
+}
+
+
+/**
+ * Struct for a tableau pivoted exactly in integers, for games with integer
+ * payoffs. Pivots are fraction free (Bareiss): every entry shares one
+ * positive denominator, the pivot element of the last pivot, and every
+ * pivot divides exactly by the denominator before it, so entries stay
+ * integers without any gcd reductions. Entries are 64-bit until one no
+ * longer fits. The whole tableau is then widened to a fixed number of limbs
+ * per entry, enough for the Hadamard bound of the initial tableau, which
+ * bounds every entry it can reach.
+ *
+ * data: rows of 64-bit entries, used until the tableau is widened
+ * wide_data: rows of wide entries, limbs limbs each, used once it is
+ * scratch: one row, so a row that overflows 64 bits can be redone wide
+ * work: scratch limbs for a wide pivot, the denominator first
+ * capacity: number of entries allocated for data
+ * scratch_capacity: number of entries allocated for scratch
+ * wide_capacity: number of limbs allocated for wide_data
+ * limbs: limbs per wide entry, 0 while entries are 64-bit
+ * overflow: the entries would need more than EXACT_MAX_LIMBS limbs, so the
+ *           tableau is no longer valid
+ * denominator: positive denominator shared by every entry while they are
+ *              64-bit, afterwards it is the first limbs of work
+ * bound_bits: bits of the Hadamard bound on the magnitude of every entry
+ * stride: distance between rows, in entries
+ * s_size: length of S
+ * x_size: length of X
+ * rows: number of rows
+ * cols: number of columns
+ * k: amount added to every payoff entry
+ */
+struct ExactTableau {
+    int64_t* data;
+    uint64_t* wide_data;
+    int64_t* scratch;
+    uint64_t* work;
+    size_t capacity;
+    int scratch_capacity;
+    size_t wide_capacity;
+    int limbs;
+    bool overflow;
+    int64_t denominator;
+    double bound_bits;
+    int stride;
+    int s_size;
+    int x_size;
+    int rows;
+    int cols;
+    long long k;
+};
+typedef struct ExactTableau ExactTableau_t;
+
+/**
+ * Gets a wide entry of an exact tableau
+ *
+ * tableau: struct to index, widened
+ * row: row index
+ * col: column index
+ *
+ * return: pointer to the limbs of the entry
+ */
+static inline uint64_t* exact_wide_entry(ExactTableau_t* tableau, int row, int col) {
+    return tableau->wide_data + ((size_t) row * tableau->stride + col) * tableau->limbs;
+}
+
+/**
+ * Reshapes an exact tableau and zeroes it in 64-bit form, keeping its
+ * storage when the new shape fits
+ *
+ * tableau: struct to reshape
+ * s_size: length of S
+ * x_size: length of X
+ */
+void reset_exact_tableau(ExactTableau_t* tableau, int s_size, int x_size) {
+    tableau->s_size = s_size;
+    tableau->x_size = x_size;
+    tableau->rows = s_size + 1;
+    tableau->cols = x_size + s_size + 1;
+    tableau->stride = tableau->cols;
+    tableau->k = 0;
+    tableau->denominator = 1;
+    tableau->bound_bits = 0;
+    tableau->limbs = 0;
+    tableau->overflow = false;
+
+    size_t size = (size_t) tableau->rows * tableau->stride;
+    if (size > tableau->capacity) {
+        free(tableau->data);
+        tableau->data = (int64_t*) malloc(size * sizeof(int64_t));
+        tableau->capacity = size;
+    }
+    // a game with fewer entries can still have wider rows
+    if (tableau->stride > tableau->scratch_capacity) {
+        free(tableau->scratch);
+        tableau->scratch = (int64_t*) malloc(tableau->stride * sizeof(int64_t));
+        tableau->scratch_capacity = tableau->stride;
+    }
+    memset(tableau->data, 0, size * sizeof(int64_t));
+}
+
+/**
+ * Initialize a new exact tableau
+ *
+ * s_size: length of S
+ * x_size: length of X
+ */
+ExactTableau_t* create_exact_tableau(int s_size, int x_size) {
+    ExactTableau_t* tableau = (ExactTableau_t*) malloc(sizeof(ExactTableau_t));
+    tableau->data = NULL;
+    tableau->wide_data = NULL;
+    tableau->scratch = NULL;
+    tableau->work = NULL;
+    tableau->capacity = 0;
+    tableau->scratch_capacity = 0;
+    tableau->wide_capacity = 0;
+    reset_exact_tableau(tableau, s_size, x_size);
+    return tableau;
+}
+
+/**
+ * Frees an exact tableau struct
+ *
+ * tableau: struct to free
+ */
+void free_exact_tableau(ExactTableau_t* tableau) {
+    free(tableau->data);
+    free(tableau->wide_data);
+    free(tableau->scratch);
+    free(tableau->work);
+    free(tableau);
+}
+
+/**
+ * Moves the entries of an exact tableau to wide storage, or to wider
+ * storage if they already are wide
+ *
+ * tableau: struct to widen
+ * limbs: limbs per entry, more than it has now
+ */
+void widen_exact_tableau(ExactTableau_t* tableau, int limbs) {
+    size_t size = (size_t) tableau->rows * tableau->stride;
+    uint64_t* wide_data = (uint64_t*) malloc(size * limbs * sizeof(uint64_t));
+    uint64_t* work = (uint64_t*) malloc(EXACT_WORK_LIMBS * limbs * sizeof(uint64_t));
+
+    int old_limbs = tableau->limbs;
+    for (size_t index = 0; index < size; index++) {
+        if (old_limbs == 0) limbs_from_int64(wide_data + index * limbs, tableau->data[index], limbs);
+        else limbs_extend(wide_data + index * limbs, limbs, tableau->wide_data + index * old_limbs, old_limbs);
+    }
+    if (old_limbs == 0) limbs_from_int64(work, tableau->denominator, limbs);
+    else limbs_extend(work, limbs, tableau->work, old_limbs);
+
+    free(tableau->wide_data);
+    free(tableau->work);
+    tableau->wide_data = wide_data;
+    tableau->wide_capacity = size * limbs;
+    tableau->work = work;
+    tableau->limbs = limbs;
+}
+
+/**
+ * Gets an entry of an exact tableau over its denominator, rounded to the
+ * nearest double. Entries are below 2^1023 in magnitude, so a nonzero entry
+ * never rounds to zero.
+ *
+ * context: exact tableau to index
+ * row: row index
+ * col: column index
+ *
+ * return: entry
+ */
+static double exact_tableau_cell(void* context, int row, int col) {
+    ExactTableau_t* tableau = (ExactTableau_t*) context;
+    if (tableau->limbs == 0)
+        return (double) tableau->data[(size_t) row * tableau->stride + col] / (double) tableau->denominator;
+    return limbs_ratio(exact_wide_entry(tableau, row, col), tableau->work, tableau->limbs);
+}
+
+/**
+ * Prints an exact tableau matrix the same way as print_tableau, rounding
+ * each entry to the nearest double
+ *
+ * stream: where to print
+ * tableau: struct to print
+ */
+void print_exact_tableau(FILE* stream, ExactTableau_t* tableau) {
+    print_cells(stream, exact_tableau_cell, tableau, tableau->s_size, tableau->x_size, tableau->rows, tableau->cols);
+}
+
+/**
+ * Fills a freshly reset exact tableau with the initial tableau of a payoff
+ * matrix, if every entry is an integer of at most EXACT_MAX_PAYOFF in
+ * magnitude, and finds the Hadamard bound of that tableau
+ *
+ * tableau: zeroed struct of s_size m and x_size n to fill
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * m: number of rows
+ * n: number of columns
+ *
+ * return: if the payoff matrix could be loaded
+ */
+bool load_exact_tableau(ExactTableau_t* tableau, const void* payoff, Dtype_t dtype, int m, int n) {
+    size_t size = (size_t) m * n;
+    for (size_t index = 0; index < size; index++) {
+        double value = payoff_entry(payoff, dtype, index);
+        if (!(fabs(value) <= EXACT_MAX_PAYOFF) || value != nearbyint(value)) return false;
+    }
+
+    long long k = (long long) payoff_shift(payoff, dtype, m, n);
+    tableau->k = k;
+
+    // every entry the pivots reach is a minor of this tableau, which is at
+    // most the product of its row lengths
+    tableau->bound_bits = log2((double) n) / 2;
+    for (int row = 0; row < m; row++) {
+        int64_t* tableau_row = tableau->data + (size_t) row * tableau->stride;
+        double length = 2; // slack and right hand side
+        for (int col = 0; col < n; col++) {
+            tableau_row[col] = (int64_t) payoff_entry(payoff, dtype, (size_t) row * n + col) + k;
+            length += (double) tableau_row[col] * tableau_row[col];
+        }
+        tableau_row[n + row] = 1;
+        tableau_row[tableau->cols - 1] = 1;
+        tableau->bound_bits += log2(length) / 2;
+    }
+
+    int64_t* objective_row = tableau->data + (size_t) m * tableau->stride;
+    for (int col = 0; col < n; col++) objective_row[col] = -1;
+    return true;
+}
+
+/**
+ * Gets an entry of a double, single precision or exact tableau
+ *
+ * tableau: struct to index, NULL if another tableau is given
+ * float_tableau: single precision struct to index, NULL if another tableau
+ *                is given
+ * exact_tableau: exact struct to index, NULL if another tableau is given
+ * row: row index
+ * col: column index
+ *
+ * return: entry, in double precision
+ */
+static inline double tableau_entry(Tableau_t* tableau, FloatTableau_t* float_tableau, ExactTableau_t* exact_tableau,
+                                   int row, int col) {
+    if (tableau != NULL) return tableau_row(tableau, row)[col];
+    if (float_tableau != NULL) return float_tableau_row(float_tableau, row)[col];
+    return exact_tableau_cell(exact_tableau, row, col);
+}
+
+
+/**
+ * Row elimination kernel: row = row - factor * pivot_row
+ *
+ * row: row being updated, TABLEAU_ALIGN aligned
+ * pivot_row: already scaled pivot row, TABLEAU_ALIGN aligned
+ * factor: entry of row in the pivot column before the update
+ * length: number of entries, a multiple of TABLEAU_PAD
+ */
+typedef void (*EliminateFn)(double* restrict row, const double* restrict pivot_row, double factor, int length);
+
+/**
+ * Portable row elimination kernel
+ */
+static void eliminate_row_scalar(double* restrict row, const double* restrict pivot_row, double factor, int length) {
+    for (int col = 0; col < length; col++)
+        row[col] = row[col] - (factor * pivot_row[col]);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/**
+ * AVX2 row elimination kernel, two fused multiply-adds per TABLEAU_PAD entries
+ */
+__attribute__((target("avx2,fma")))
+static void eliminate_row_avx2(double* restrict row, const double* restrict pivot_row, double factor, int length) {
+    __m256d f = _mm256_set1_pd(factor);
+    for (int col = 0; col < length; col += 8) {
+        __m256d r0 = _mm256_load_pd(row + col);
+        __m256d r1 = _mm256_load_pd(row + col + 4);
+        r0 = _mm256_fnmadd_pd(f, _mm256_load_pd(pivot_row + col), r0);
+        r1 = _mm256_fnmadd_pd(f, _mm256_load_pd(pivot_row + col + 4), r1);
+        _mm256_store_pd(row + col, r0);
+        _mm256_store_pd(row + col + 4, r1);
+    }
+}
+
+/**
+ * AVX-512 row elimination kernel, one fused multiply-add per TABLEAU_PAD entries
+ */
+__attribute__((target("avx512f")))
+static void eliminate_row_avx512(double* restrict row, const double* restrict pivot_row, double factor, int length) {
+    __m512d f = _mm512_set1_pd(factor);
+    for (int col = 0; col < length; col += 8) {
+        __m512d r = _mm512_load_pd(row + col);
+        r = _mm512_fnmadd_pd(f, _mm512_load_pd(pivot_row + col), r);
+        _mm512_store_pd(row + col, r);
+    }
+}
+#elif defined(__aarch64__)
+/**
+ * NEON row elimination kernel, four fused multiply-subtracts per TABLEAU_PAD entries
+ */
+static void eliminate_row_neon(double* restrict row, const double* restrict pivot_row, double factor, int length) {
+    float64x2_t f = vdupq_n_f64(factor);
+    for (int col = 0; col < length; col += 8) {
+        for (int lane = 0; lane < 8; lane += 2) {
+            float64x2_t r = vld1q_f64(row + col + lane);
+            r = vfmsq_f64(r, vld1q_f64(pivot_row + col + lane), f);
+            vst1q_f64(row + col + lane, r);
+        }
+    }
+}
+#endif
+
+/**
+ * Picks the widest elimination kernel the running CPU supports
+ *
+ * return: kernel to use for row elimination
+ */
+EliminateFn select_eliminate_kernel() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return eliminate_row_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return eliminate_row_avx2;
+#elif defined(__aarch64__)
+    return eliminate_row_neon;
+#endif
+    return eliminate_row_scalar;
+}
+
+// resolved to the best kernel by resolve_kernels, once
+static EliminateFn eliminate_row = eliminate_row_scalar;
+
+/**
+ * Single precision row elimination kernel: row = row - factor * pivot_row
+ *
+ * row: row being updated, TABLEAU_ALIGN aligned
+ * pivot_row: already scaled pivot row, TABLEAU_ALIGN aligned
+ * factor: entry of row in the pivot column before the update
+ * length: number of entries, a multiple of FLOAT_TABLEAU_PAD
+ */
+typedef void (*EliminateFloatFn)(float* restrict row, const float* restrict pivot_row, float factor, int length);
+
+/**
+ * Portable single precision row elimination kernel
+ */
+static void eliminate_float_row_scalar(float* restrict row, const float* restrict pivot_row, float factor, int length) {
+    for (int col = 0; col < length; col++)
+        row[col] = row[col] - (factor * pivot_row[col]);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/**
+ * AVX2 single precision row elimination kernel, two fused multiply-adds per
+ * FLOAT_TABLEAU_PAD entries
+ */
+__attribute__((target("avx2,fma")))
+static void eliminate_float_row_avx2(float* restrict row, const float* restrict pivot_row, float factor, int length) {
+    __m256 f = _mm256_set1_ps(factor);
+    for (int col = 0; col < length; col += 16) {
+        __m256 r0 = _mm256_load_ps(row + col);
+        __m256 r1 = _mm256_load_ps(row + col + 8);
+        r0 = _mm256_fnmadd_ps(f, _mm256_load_ps(pivot_row + col), r0);
+        r1 = _mm256_fnmadd_ps(f, _mm256_load_ps(pivot_row + col + 8), r1);
+        _mm256_store_ps(row + col, r0);
+        _mm256_store_ps(row + col + 8, r1);
+    }
+}
+
+/**
+ * AVX-512 single precision row elimination kernel, one fused multiply-add per
+ * FLOAT_TABLEAU_PAD entries
+ */
+__attribute__((target("avx512f")))
+static void eliminate_float_row_avx512(float* restrict row, const float* restrict pivot_row, float factor, int length) {
+    __m512 f = _mm512_set1_ps(factor);
+    for (int col = 0; col < length; col += 16) {
+        __m512 r = _mm512_load_ps(row + col);
+        r = _mm512_fnmadd_ps(f, _mm512_load_ps(pivot_row + col), r);
+        _mm512_store_ps(row + col, r);
+    }
+}
+#elif defined(__aarch64__)
+/**
+ * NEON single precision row elimination kernel, four fused multiply-subtracts
+ * per FLOAT_TABLEAU_PAD entries
+ */
+static void eliminate_float_row_neon(float* restrict row, const float* restrict pivot_row, float factor, int length) {
+    float32x4_t f = vdupq_n_f32(factor);
+    for (int col = 0; col < length; col += 16) {
+        for (int lane = 0; lane < 16; lane += 4) {
+            float32x4_t r = vld1q_f32(row + col + lane);
+            r = vfmsq_f32(r, vld1q_f32(pivot_row + col + lane), f);
+            vst1q_f32(row + col + lane, r);
+        }
+    }
+}
+#endif
+
+/**
+ * Picks the widest single precision elimination kernel the running CPU
+ * supports
+ *
+ * return: kernel to use for single precision row elimination
+ */
+EliminateFloatFn select_eliminate_float_kernel() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return eliminate_float_row_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return eliminate_float_row_avx2;
+#elif defined(__aarch64__)
+    return eliminate_float_row_neon;
+#endif
+    return eliminate_float_row_scalar;
+}
+
+// resolved to the best kernel by resolve_kernels, once
+static EliminateFloatFn eliminate_float_row = eliminate_float_row_scalar;
+
+static pthread_once_t kernels_resolved = PTHREAD_ONCE_INIT;
+
+/**
+ * Resolves eliminate_row and eliminate_float_row for the running CPU. Only
+ * run through pthread_once from create_workspace, which every solve goes
+ * through, so the kernels are written once before any thread pivots.
+ */
+static void resolve_kernels() {
+    eliminate_row = select_eliminate_kernel();
+    eliminate_float_row = select_eliminate_float_kernel();
+}
+
+/**
+ * Struct to store a pivot result
+ *
+ * success: if the pivot was successful
+ * pivot_row: row of the pivot used
+ * pivot_col: col of the pivot used
+ */
+struct PivotResult {
+    bool success;
+    int pivot_row;
+    int pivot_col;
+};
+typedef struct PivotResult PivotResult_t;
+
+/**
+ * Gets the reduced cost of a column, the entry of the tableau objective row
+ *
+ * context: engine being priced
+ * col: column index, n + i for slack i
+ *
+ * return: reduced cost, 0 for basic columns
+ */
+typedef double (*PriceFn)(void* context, int col);
+
+/**
+ * Struct for the state of a pivot rule between pivots
+ *
+ * rule: pivot rule in use
+ * count: number of columns that can enter, payoff and slack
+ * weights: squared edge lengths for steepest edge and devex, 1 for basic
+ *          columns
+ * window: number of columns partial pricing scans at a time
+ * offset: column partial pricing scans from next
+ * candidates: columns kept by multiple pricing, best first
+ * candidate_count: number of entries in candidates
+ * capacity: number of weights allocated
+ * basis: column basic in each row, which breaks ratio test ties under
+ *        Bland's rule, NULL for the revised engine that keeps its own
+ */
+struct Pricing {
+    PivotRule_t rule;
+    int count;
+    double* weights;
+    int capacity;
+    int window;
+    int offset;
+    int* candidates;
+    int candidate_count;
+    const int* basis;
+};
+typedef struct Pricing Pricing_t;
+
+/**
+ * Restarts the state of a pivot rule for a new problem, reusing the weights
+ * when they are long enough
+ *
+ * pricing: state to restart
+ * count: number of columns that can enter, payoff and slack
+ */
+void reset_pricing(Pricing_t* pricing, int count) {
+    pricing->count = count;
+    if (count > pricing->capacity) {
+        free(pricing->weights);
+        pricing->weights = (double*) calloc(count, sizeof(double));
+        pricing->capacity = count;
+    }
+    for (int col = 0; col < count; col++) pricing->weights[col] = 1;
+
+    pricing->window = count / PARTIAL_PRICING_SECTIONS;
+    if (pricing->window < PARTIAL_PRICING_MIN_WINDOW) pricing->window = PARTIAL_PRICING_MIN_WINDOW;
+    pricing->offset = 0;
+    pricing->candidate_count = 0;
+}
+
+/**
+ * Creates the state for a pivot rule
+ *
+ * rule: pivot rule to use
+ * count: number of columns that can enter, payoff and slack
+ *
+ * return: pricing state with unit weights
+ */
+Pricing_t* create_pricing(PivotRule_t rule, int count) {
+    Pricing_t* pricing = (Pricing_t*) malloc(sizeof(Pricing_t));
+    pricing->rule = rule;
+    pricing->weights = NULL;
+    pricing->capacity = 0;
+    pricing->candidates = (int*) calloc(MULTIPLE_PRICING_CANDIDATES, sizeof(int));
+    pricing->basis = NULL;
+    reset_pricing(pricing, count);
+    return pricing;
+}
+
+/**
+ * Frees pricing state
+ *
+ * pricing: state to free
+ */
+void free_pricing(Pricing_t* pricing) {
+    free(pricing->weights);
+    free(pricing->candidates);
+    free(pricing);
+}
+
+/**
+ * Chooses the entering column with the pricing state's rule. Ties go to the
+ * lowest column, like the tableau scan.
+ *
+ * pricing: pricing state, updated for partial and multiple pricing
+ * price: gets reduced costs on demand
+ * context: passed to price
+ * tolerance: reduced costs must be below -tolerance to enter
+ *
+ * return: entering column, -1 if none has a negative reduced cost
+ */
+int select_column(Pricing_t* pricing, PriceFn price, void* context, double tolerance) {
+    int count = pricing->count;
+
+    if (pricing->rule == RULE_BLAND) {
+        for (int col = 0; col < count; col++) {
+            if (price(context, col) < -tolerance) return col;
+        }
+        return -1;
+    }
+
+    if (pricing->rule == RULE_PARTIAL) {
+        // scan windows in turn, stopping at the first with a candidate
+        for (int scanned = 0; scanned < count; scanned += pricing->window) {
+            int start = pricing->offset;
+            int end = (start + pricing->window < count)? start + pricing->window : count;
+            pricing->offset = (end == count)? 0 : end;
+
+            double min_value = -tolerance;
+            int pivot_col = -1;
+            for (int col = start; col < end; col++) {
+                double value = price(context, col);
+                if (value < min_value) {
+                    min_value = value;
+                    pivot_col = col;
+                }
+            }
+            if (pivot_col >= 0) return pivot_col;
+        }
+        return -1;
+    }
+
+    if (pricing->rule == RULE_MULTIPLE) {
+        // minor iteration on the kept candidates while one is still attractive
+        double min_value = -tolerance;
+        int pivot_col = -1;
+        for (int index = 0; index < pricing->candidate_count; index++) {
+            double value = price(context, pricing->candidates[index]);
+            if (value < min_value) {
+                min_value = value;
+                pivot_col = pricing->candidates[index];
+            }
+        }
+        if (pivot_col >= 0) return pivot_col;
+
+        // major iteration: full scan keeping the most negative columns
+        double values[MULTIPLE_PRICING_CANDIDATES];
+        pricing->candidate_count = 0;
+        for (int col = 0; col < count; col++) {
+            double value = price(context, col);
+            if (value >= -tolerance) continue;
+
+            int index = pricing->candidate_count;
+            if (index == MULTIPLE_PRICING_CANDIDATES) {
+                if (value >= values[index - 1]) continue;
+                index--;
+            }
+            else {
+                pricing->candidate_count++;
+            }
+
+            // insertion sort, keeping earlier columns ahead on ties
+            while (index > 0 && values[index - 1] > value) {
+                pricing->candidates[index] = pricing->candidates[index - 1];
+                values[index] = values[index - 1];
+                index--;
+            }
+            pricing->candidates[index] = col;
+            values[index] = value;
+        }
+        return (pricing->candidate_count > 0)? pricing->candidates[0] : -1;
+    }
+
+    // dantzig and the weighted rules scan every column
+    bool weighted = pricing->rule == RULE_STEEPEST_EDGE || pricing->rule == RULE_DEVEX;
+    double best = (weighted)? 0 : -tolerance;
+    int pivot_col = -1;
+    for (int col = 0; col < count; col++) {
+        double value = price(context, col);
+        if (value >= -tolerance) continue;
+
+        double score = (weighted)? -(value * value) / pricing->weights[col] : value;
+        if (score < best) {
+            best = score;
+            pivot_col = col;
+        }
+    }
+    return pivot_col;
+}
+
+/**
+ * Updates devex reference weights after a pivot
+ *
+ * pricing: pricing state to update
+ * pivot_col: column that entered
+ * ratios: pivot row divided by the pivot element, so the leaving column
+ *         has 1 / pivot element and basic columns have 0
+ */
+void update_devex_weights(Pricing_t* pricing, int pivot_col, const double* ratios) {
+    double entering = pricing->weights[pivot_col];
+    for (int col = 0; col < pricing->count; col++) {
+        if (col == pivot_col || ratios[col] == 0) continue;
+
+        double weight = ratios[col] * ratios[col] * entering;
+        if (weight > pricing->weights[col]) pricing->weights[col] = weight;
+    }
+    pricing->weights[pivot_col] = 1;
+}
+
+/**
+ * Gets a reduced cost from the objective row of a tableau
+ *
+ * context: tableau being priced
+ * col: column index
+ *
+ * return: objective row entry
+ */
+double tableau_price(void* context, int col) {
+    Tableau_t* tableau = (Tableau_t*) context;
+    return tableau_row(tableau, tableau->rows - 1)[col];
+}
+
+/**
+ * Recomputes the pricing weights of a tableau. Steepest edge uses the exact
+ * squared edge lengths, which costs one pass over the tableau, and devex
+ * updates its reference weights from the pivot row.
+ *
+ * pricing: pricing state to update
+ * tableau: tableau after the pivot
+ * pivot_row: row of the pivot, -1 to initialize
+ * pivot_col: col of the pivot, -1 to initialize
+ */
+void update_tableau_pricing(Pricing_t* pricing, Tableau_t* tableau, int pivot_row, int pivot_col) {
+    if (pricing->rule == RULE_STEEPEST_EDGE) {
+        // accumulate row by row so the pass streams through memory
+        for (int col = 0; col < pricing->count; col++) pricing->weights[col] = 1;
+        for (int row = 0; row < tableau->s_size; row++) {
+            double* cur_row = tableau_row(tableau, row);
+            for (int col = 0; col < pricing->count; col++)
+                pricing->weights[col] += cur_row[col] * cur_row[col];
+        }
+    }
+    else if (pricing->rule == RULE_DEVEX && pivot_row >= 0) {
+        update_devex_weights(pricing, pivot_col, tableau_row(tableau, pivot_row));
+    }
+}
+
+/**
+ * Gets a reduced cost from the objective row of a single precision tableau
+ *
+ * context: single precision tableau being priced
+ * col: column index
+ *
+ * return: objective row entry
+ */
+double float_tableau_price(void* context, int col) {
+    FloatTableau_t* tableau = (FloatTableau_t*) context;
+    return float_tableau_row(tableau, tableau->rows - 1)[col];
+}
+
+/**
+ * Recomputes the pricing weights of a single precision tableau, like
+ * update_tableau_pricing. The weights themselves are kept in double
+ * precision.
+ *
+ * pricing: pricing state to update
+ * tableau: single precision tableau after the pivot
+ * pivot_row: row of the pivot, -1 to initialize
+ * pivot_col: col of the pivot, -1 to initialize
+ */
+void update_float_tableau_pricing(Pricing_t* pricing, FloatTableau_t* tableau, int pivot_row, int pivot_col) {
+    if (pricing->rule == RULE_STEEPEST_EDGE) {
+        for (int col = 0; col < pricing->count; col++) pricing->weights[col] = 1;
+        for (int row = 0; row < tableau->s_size; row++) {
+            float* cur_row = float_tableau_row(tableau, row);
+            for (int col = 0; col < pricing->count; col++)
+                pricing->weights[col] += (double) cur_row[col] * cur_row[col];
+        }
+    }
+    else if (pricing->rule == RULE_DEVEX && pivot_row >= 0) {
+        // same update as update_devex_weights, reading the float pivot row
+        float* ratios = float_tableau_row(tableau, pivot_row);
+        double entering = pricing->weights[pivot_col];
+        for (int col = 0; col < pricing->count; col++) {
+            if (col == pivot_col || ratios[col] == 0) continue;
+
+            double weight = (double) ratios[col] * ratios[col] * entering;
+            if (weight > pricing->weights[col]) pricing->weights[col] = weight;
+        }
+        pricing->weights[pivot_col] = 1;
+    }
+}
+
+/**
+ * Gets a reduced cost from the objective row of an exact tableau, rounded to
+ * the nearest double, which keeps its sign
+ *
+ * context: exact tableau being priced
+ * col: column index
+ *
+ * return: objective row entry
+ */
+double exact_tableau_price(void* context, int col) {
+    ExactTableau_t* tableau = (ExactTableau_t*) context;
+    return exact_tableau_cell(tableau, tableau->rows - 1, col);
+}
+
+/**
+ * Recomputes the pricing weights of an exact tableau, like
+ * update_tableau_pricing. Weights only steer the choice of column, so they
+ * are kept in double precision.
+ *
+ * pricing: pricing state to update
+ * tableau: exact tableau after the pivot
+ * pivot_row: row of the pivot, -1 to initialize
+ * pivot_col: col of the pivot, -1 to initialize
+ */
+void update_exact_tableau_pricing(Pricing_t* pricing, ExactTableau_t* tableau, int pivot_row, int pivot_col) {
+    if (pricing->rule == RULE_STEEPEST_EDGE) {
+        for (int col = 0; col < pricing->count; col++) pricing->weights[col] = 1;
+        for (int row = 0; row < tableau->s_size; row++) {
+            for (int col = 0; col < pricing->count; col++) {
+                double value = exact_tableau_cell(tableau, row, col);
+                pricing->weights[col] += value * value;
+            }
+        }
+    }
+    else if (pricing->rule == RULE_DEVEX && pivot_row >= 0) {
+        // same update as update_devex_weights, the pivot row over the
+        // denominator being the ratios
+        double entering = pricing->weights[pivot_col];
+        for (int col = 0; col < pricing->count; col++) {
+            double ratio = exact_tableau_cell(tableau, pivot_row, col);
+            if (col == pivot_col || ratio == 0) continue;
+
+            double weight = ratio * ratio * entering;
+            if (weight > pricing->weights[col]) pricing->weights[col] = weight;
+        }
+        pricing->weights[pivot_col] = 1;
+    }
+}
+
+
+/**
+ * Lists the runs of TABLEAU_PAD entry chunks a scaled pivot row is not all
+ * zero in, the only entries a pivot changes in the other rows. A slack basic
+ * in another row has a unit column the pivot row is exactly zero in, so on
+ * games with many more rows than columns most of the slack block is skipped.
+ *
+ * tableau: struct being pivoted, whose spans are set to the start and length
+ *          of each run
+ * pivot_row: scaled pivot row
+ *
+ * return: number of runs, 0 when too few chunks are zero to leave out
+ */
+int list_pivot_spans(Tableau_t* tableau, const double* pivot_row) {
+    int chunks = tableau->stride / TABLEAU_PAD;
+    if (tableau->span_capacity < chunks + 1) {
+        free(tableau->spans);
+        tableau->spans = (int*) malloc((chunks + 1) * sizeof(int));
+        tableau->span_capacity = chunks + 1;
+    }
+
+    int count = 0;
+    int active = 0;
+    for (int chunk = 0; chunk < chunks; chunk++) {
+        const double* entries = pivot_row + chunk * TABLEAU_PAD;
+        bool zero = true;
+        for (int entry = 0; entry < TABLEAU_PAD && zero; entry++) zero = (entries[entry] == 0);
+        if (zero) continue;
+
+        int start = chunk * TABLEAU_PAD;
+        if (count > 0 && tableau->spans[2 * count - 2] + tableau->spans[2 * count - 1] == start) {
+            tableau->spans[2 * count - 1] += TABLEAU_PAD;
+        } else {
+            tableau->spans[2 * count] = start;
+            tableau->spans[2 * count + 1] = TABLEAU_PAD;
+            count++;
+        }
+        active++;
+    }
+    return (active > SPAN_DENSITY * chunks)? 0 : count;
+}
+
+/**
+ * Eliminates a row over the runs list_pivot_spans found, with the same
+ * kernel and so the same rounding as eliminating the whole row
+ *
+ * row: row being updated
+ * pivot_row: scaled pivot row
+ * factor: entry of row in the pivot column before the update
+ * spans: start and length of each run
+ * count: number of runs
+ */
+static inline void eliminate_spans(double* row, const double* pivot_row, double factor, const int* spans, int count) {
+    for (int span = 0; span < count; span++)
+        eliminate_row(row + spans[2 * span], pivot_row + spans[2 * span], factor, spans[2 * span + 1]);
+}
+
+/**
+ * Pivots a tableau in place on a given entry, which must not be zero
+ *
+ * tableau: struct to pivot
+ * pivot_row: row of the pivot
+ * pivot_col: col of the pivot
+ */
+void pivot_tableau_at(Tableau_t* tableau, int pivot_row, int pivot_col) {
+    STATS_START(eliminate_start);
+
+    // update pivot row
+    double* new_pivot_row = tableau_row(tableau, pivot_row);
+    double pivot_value = new_pivot_row[pivot_col];
+    for (int col = 0; col < tableau->cols; col++)
+        new_pivot_row[col] = new_pivot_row[col] / pivot_value;
+    int span_count = list_pivot_spans(tableau, new_pivot_row);
+
+    // update other rows, saving the pivot column entry before it is overwritten.
+    // rows with a zero there are unchanged by the pivot, and the padding after
+    // cols is zero in every row so the kernel can run over the full stride
+    for (int row = 0; row < tableau->rows; row++) {
+        stream_tableau_panel(tableau, row, 0, tableau->rows);
+        if (row == pivot_row) continue;
+
+        double* cur_row = tableau_row(tableau, row);
+        double factor = cur_row[pivot_col];
+        if (factor == 0) {
+            STATS_ADD(skipped_rows, 1);
+            continue;
+        }
+
+        if (span_count > 0) eliminate_spans(cur_row, new_pivot_row, factor, tableau->spans, span_count);
+        else eliminate_row(cur_row, new_pivot_row, factor, tableau->stride);
+    }
+    STATS_CYCLES(eliminate_cycles, eliminate_start);
+}
+
+/**
+ * Struct for what the first pass of Harris' ratio test finds over some rows
+ *
+ * bound: smallest ratio with every right hand side relaxed by the
+ *        feasibility tolerance, DBL_MAX if no row can leave
+ * ratio: smallest ratio of the right hand sides themselves, DBL_MAX if no
+ *        row can leave
+ * entry: largest pivot column entry above the pivot tolerance, 0 if none
+ */
+struct RatioBounds {
+    double bound;
+    double ratio;
+    double entry;
+};
+typedef struct RatioBounds RatioBounds_t;
+
+/**
+ * Adds a row that can leave to the first pass of Harris' ratio test
+ *
+ * bounds: first pass so far
+ * rhs: right hand side of the row, at least zero
+ * entry: pivot column entry of the row, above the pivot tolerance
+ * feasibility_tolerance: how far right hand sides may go below zero
+ */
+static inline void add_ratio_bound(RatioBounds_t* bounds, double rhs, double entry, double feasibility_tolerance) {
+    bounds->bound = fmin(bounds->bound, (rhs + feasibility_tolerance) / entry);
+    bounds->ratio = fmin(bounds->ratio, rhs / entry);
+    bounds->entry = fmax(bounds->entry, entry);
+}
+
+/**
+ * Scores a row within the bound for the second pass of Harris' ratio test,
+ * the lowest score leaving. Without Bland's rule the largest entry wins.
+ * Under it, rows within the tie tolerance of the smallest ratio whose entry is at least BLAND_PIVOT_FRACTION of the largest win by lowest
+ * basic column, and only when there are none does the largest entry win, so
+ * a pivot barely above the tolerance is never taken for its index alone.
+ *
+ * bounds: first pass over every row
+ * rhs: right hand side of the row, at least zero
+ * entry: pivot column entry of the row
+ * tie_tolerance: how far above the smallest ratio a ratio still ties
+ * basic: column basic in the row, -1 for the largest entry
+ *
+ * return: score of the row, comparable across rows of the same bounds
+ */
+static inline double harris_score(const RatioBounds_t* bounds, double rhs, double entry, double tie_tolerance,
+                                  int basic) {
+    if (basic < 0) return -entry;
+    if (entry >= BLAND_PIVOT_FRACTION * bounds->entry && rhs / entry <= bounds->ratio + tie_tolerance)
+        return basic;
+    // after every basic column, largest entry first
+    return (double) INT_MAX + 1 - entry / bounds->entry;
+}
+
+/**
+ * Combines first passes of Harris' ratio test over disjoint rows
+ *
+ * bounds: first pass to add to
+ * other: first pass over other rows
+ */
+static inline void merge_ratio_bounds(RatioBounds_t* bounds, const RatioBounds_t* other) {
+    bounds->bound = fmin(bounds->bound, other->bound);
+    bounds->ratio = fmin(bounds->ratio, other->ratio);
+    bounds->entry = fmax(bounds->entry, other->entry);
+}
+
+/**
+ * Runs the first pass of Harris' ratio test over some rows of a tableau.
+ * With every right hand side relaxed by the feasibility tolerance, the
+ * smallest ratio bounds how far the entering variable can move without any
+ * basic variable going further below zero than that.
+ *
+ * tableau: struct to choose the pivot row of
+ * pivot_col: entering column
+ * start: first row to consider
+ * end: one past the last row to consider
+ * bounds: filled with the bound and what Bland's rule ties by
+ */
+void harris_bound(Tableau_t* tableau, int pivot_col, int start, int end, RatioBounds_t* bounds) {
+    *bounds = (RatioBounds_t) { DBL_MAX, DBL_MAX, 0 };
+    for (int row = start; row < end && row < tableau->s_size; row++) {
+        double* cur_row = tableau_row(tableau, row);
+        if (cur_row[pivot_col] <= tableau->pivot_tolerance) continue;
+
+        add_ratio_bound(bounds, fmax(cur_row[tableau->cols - 1], 0), cur_row[pivot_col], tableau->feasibility_tolerance);
+    }
+}
+
+/**
+ * Runs the second pass of Harris' ratio test over some rows of a tableau.
+ * Of the rows whose ratio is within the bound, the one with the largest
+ * pivot column entry leaves, which keeps the pivot element away from zero
+ * and lets degenerate rows with a zero ratio leave. Under Bland's rule the
+ * tie with the lowest basic column leaves instead, see harris_score.
+ *
+ * tableau: struct to choose the pivot row of
+ * pivot_col: entering column
+ * start: first row to consider
+ * end: one past the last row to consider
+ * bounds: first pass, over every row
+ * basis: column basic in each row for Bland's rule, NULL for the largest
+ *        entry
+ * score: set to the harris_score of the row chosen, DBL_MAX if none was
+ *        chosen
+ *
+ * return: leaving row, -1 if no row can leave
+ */
+int harris_select(Tableau_t* tableau, int pivot_col, int start, int end, const RatioBounds_t* bounds,
+                  const int* basis, double* score) {
+    int pivot_row = -1;
+    *score = DBL_MAX;
+    for (int row = start; row < end && row < tableau->s_size; row++) {
+        double* cur_row = tableau_row(tableau, row);
+        double entry = cur_row[pivot_col];
+        double rhs = fmax(cur_row[tableau->cols - 1], 0);
+        if (entry <= tableau->pivot_tolerance || rhs / entry > bounds->bound) continue;
+
+        double value = harris_score(bounds, rhs, entry, tableau->feasibility_tolerance, (basis != NULL)? basis[row] : -1);
+        if (value < *score) {
+            *score = value;
+            pivot_row = row;
+        }
+    }
+    return pivot_row;
+}
+
+/**
+ * Chooses the leaving row of a tableau with Harris' two pass ratio test.
+ * Pivot column entries at most the pivot tolerance cannot pivot.
+ *
+ * tableau: struct to choose the pivot row of
+ * pivot_col: entering column
+ * basis: column basic in each row for Bland's rule, NULL otherwise
+ *
+ * return: leaving row, -1 if no row can leave
+ */
+int ratio_test(Tableau_t* tableau, int pivot_col, const int* basis) {
+    double score;
+    RatioBounds_t bounds;
+    harris_bound(tableau, pivot_col, 0, tableau->rows, &bounds);
+    return harris_select(tableau, pivot_col, 0, tableau->rows, &bounds, basis, &score);
+}
+
+/**
+ * Gets the basis that breaks ratio test ties under a pivot rule
+ *
+ * pricing: pivot rule state, NULL for dantzig's rule
+ *
+ * return: column basic in each row under Bland's rule, NULL otherwise
+ */
+static inline const int* tie_basis(Pricing_t* pricing) {
+    return (pricing != NULL && pricing->rule == RULE_BLAND)? pricing->basis : NULL;
+}
+
+/**
+ * Chooses the entering column of a tableau from its objective row
+ *
+ * tableau: struct to choose the pivot column of
+ * pricing: pivot rule state, NULL for dantzig's rule
+ *
+ * return: entering column, -1 if the tableau is optimal
+ */
+int select_tableau_column(Tableau_t* tableau, Pricing_t* pricing) {
+    if (pricing != NULL && pricing->rule != RULE_DANTZIG) return select_column(pricing, tableau_price, tableau, 0);
+
+    double min_value = 0; // trying to find most negative number
+    int pivot_col = -1;
+    double* objective_row = tableau_row(tableau, tableau->rows - 1);
+    for (int col = 0; col < tableau->cols; col++) {
+        double value = objective_row[col];
+        if (value < min_value) {
+            min_value = value;
+            pivot_col = col;
+        }
+    }
+    return pivot_col;
+}
+
+/**
+ * Pivots the provided tableau in place. No memory is allocated, so the
+ * caller owns both the tableau and the result.
+ *
+ * tableau: struct to pivot
+ * pricing: pivot rule state, NULL for dantzig's rule
+ * result: filled with the pivot used
+ */
+void pivot_tableau(Tableau_t* tableau, Pricing_t* pricing, PivotResult_t* result) {
+    STATS_START(select_start);
+
+    // find pivot column
+    int pivot_col = select_tableau_column(tableau, pricing);
+    result->pivot_col = pivot_col;
+    // bounds check for pivot column
+    if (pivot_col < 0) {
+        result->success = false;
+        return;
+    }
+
+    int pivot_row = ratio_test(tableau, pivot_col, tie_basis(pricing));
+
+    result->pivot_row = pivot_row;
+    // bounds check for pivot row
+    if (pivot_row < 0) {
+        result->success = false;
+        return;
+    }
+
+    STATS_CYCLES(select_cycles, select_start);
+    pivot_tableau_at(tableau, pivot_row, pivot_col);
+    if (pricing != NULL) update_tableau_pricing(pricing, tableau, pivot_row, pivot_col);
+    result->success = true;
+}
+
+/**
+ * Lists the runs of FLOAT_TABLEAU_PAD entry chunks a scaled pivot row of a
+ * single precision tableau is not all zero in, like list_pivot_spans
+ *
+ * tableau: struct being pivoted, whose spans are set
+ * pivot_row: scaled pivot row
+ *
+ * return: number of runs, 0 when too few chunks are zero to leave out
+ */
+int list_float_pivot_spans(FloatTableau_t* tableau, const float* pivot_row) {
+    int chunks = tableau->stride / FLOAT_TABLEAU_PAD;
+    if (tableau->span_capacity < chunks + 1) {
+        free(tableau->spans);
+        tableau->spans = (int*) malloc((chunks + 1) * sizeof(int));
+        tableau->span_capacity = chunks + 1;
+    }
+
+    int count = 0;
+    int active = 0;
+    for (int chunk = 0; chunk < chunks; chunk++) {
+        const float* entries = pivot_row + chunk * FLOAT_TABLEAU_PAD;
+        bool zero = true;
+        for (int entry = 0; entry < FLOAT_TABLEAU_PAD && zero; entry++) zero = (entries[entry] == 0);
+        if (zero) continue;
+
+        int start = chunk * FLOAT_TABLEAU_PAD;
+        if (count > 0 && tableau->spans[2 * count - 2] + tableau->spans[2 * count - 1] == start) {
+            tableau->spans[2 * count - 1] += FLOAT_TABLEAU_PAD;
+        } else {
+            tableau->spans[2 * count] = start;
+            tableau->spans[2 * count + 1] = FLOAT_TABLEAU_PAD;
+            count++;
+        }
+        active++;
+    }
+    return (active > SPAN_DENSITY * chunks)? 0 : count;
+}
+
+/**
+ * Eliminates a row of a single precision tableau over the runs
+ * list_float_pivot_spans found
+ *
+ * row: row being updated
+ * pivot_row: scaled pivot row
+ * factor: entry of row in the pivot column before the update
+ * spans: start and length of each run
+ * count: number of runs
+ */
+static inline void eliminate_float_spans(float* row, const float* pivot_row, float factor, const int* spans, int count) {
+    for (int span = 0; span < count; span++)
+        eliminate_float_row(row + spans[2 * span], pivot_row + spans[2 * span], factor, spans[2 * span + 1]);
+}
+
+/**
+ * Pivots a single precision tableau in place on a given entry, which must
+ * not be zero
+ *
+ * tableau: struct to pivot
+ * pivot_row: row of the pivot
+ * pivot_col: col of the pivot
+ */
+void pivot_float_tableau_at(FloatTableau_t* tableau, int pivot_row, int pivot_col) {
+    STATS_START(eliminate_start);
+    float* new_pivot_row = float_tableau_row(tableau, pivot_row);
+    float pivot_value = new_pivot_row[pivot_col];
+    for (int col = 0; col < tableau->cols; col++)
+        new_pivot_row[col] = new_pivot_row[col] / pivot_value;
+    int span_count = list_float_pivot_spans(tableau, new_pivot_row);
+
+    for (int row = 0; row < tableau->rows; row++) {
+        if (row == pivot_row) continue;
+
+        float* cur_row = float_tableau_row(tableau, row);
+        float factor = cur_row[pivot_col];
+        if (factor == 0) {
+            STATS_ADD(skipped_rows, 1);
+            continue;
+        }
+
+        if (span_count > 0) eliminate_float_spans(cur_row, new_pivot_row, factor, tableau->spans, span_count);
+        else eliminate_float_row(cur_row, new_pivot_row, factor, tableau->stride);
+    }
+    STATS_CYCLES(eliminate_cycles, eliminate_start);
+}
+
+/**
+ * Runs the first pass of Harris' ratio test over some rows of a single
+ * precision tableau, like harris_bound
+ *
+ * tableau: struct to choose the pivot row of
+ * pivot_col: entering column
+ * start: first row to consider
+ * end: one past the last row to consider
+ * bounds: filled with the bound and what Bland's rule ties by
+ */
+void float_harris_bound(FloatTableau_t* tableau, int pivot_col, int start, int end, RatioBounds_t* bounds) {
+    *bounds = (RatioBounds_t) { DBL_MAX, DBL_MAX, 0 };
+    for (int row = start; row < end && row < tableau->s_size; row++) {
+        float* cur_row = float_tableau_row(tableau, row);
+        if (cur_row[pivot_col] <= tableau->pivot_tolerance) continue;
+
+        add_ratio_bound(bounds, fmax(cur_row[tableau->cols - 1], 0), cur_row[pivot_col], tableau->feasibility_tolerance);
+    }
+}
+
+/**
+ * Runs the second pass of Harris' ratio test over some rows of a single
+ * precision tableau, like harris_select
+ *
+ * tableau: struct to choose the pivot row of
+ * pivot_col: entering column
+ * start: first row to consider
+ * end: one past the last row to consider
+ * bounds: first pass, over every row
+ * basis: column basic in each row for Bland's rule, NULL for the largest
+ *        entry
+ * score: set to the harris_score of the row chosen, DBL_MAX if none was
+ *        chosen
+ *
+ * return: leaving row, -1 if no row can leave
+ */
+int float_harris_select(FloatTableau_t* tableau, int pivot_col, int start, int end, const RatioBounds_t* bounds,
+                        const int* basis, double* score) {
+    // single precision ratios are only good to a fraction of themselves, so
+    // bland's rule ties them relative to the smallest one, not absolutely
+    double tie_tolerance = tableau->feasibility_tolerance * fmax(bounds->ratio, 1);
+    int pivot_row = -1;
+    *score = DBL_MAX;
+    for (int row = start; row < end && row < tableau->s_size; row++) {
+        float* cur_row = float_tableau_row(tableau, row);
+        double entry = cur_row[pivot_col];
+        double rhs = fmax(cur_row[tableau->cols - 1], 0);
+        if (entry <= tableau->pivot_tolerance || rhs / entry > bounds->bound) continue;
+
+        double value = harris_score(bounds, rhs, entry, tie_tolerance, (basis != NULL)? basis[row] : -1);
+        if (value < *score) {
+            *score = value;
+            pivot_row = row;
+        }
+    }
+    return pivot_row;
+}
+
+/**
+ * Chooses the leaving row of a single precision tableau with Harris' two
+ * pass ratio test, like ratio_test. Its default tolerances are wider, since
+ * only about six digits of each entry can be trusted.
+ *
+ * tableau: struct to choose the pivot row of
+ * pivot_col: entering column
+ * basis: column basic in each row for Bland's rule, NULL otherwise
+ *
+ * return: leaving row, -1 if no row can leave
+ */
+int float_ratio_test(FloatTableau_t* tableau, int pivot_col, const int* basis) {
+    double score;
+    RatioBounds_t bounds;
+    float_harris_bound(tableau, pivot_col, 0, tableau->rows, &bounds);
+    return float_harris_select(tableau, pivot_col, 0, tableau->rows, &bounds, basis, &score);
+}
+
+/**
+ * Pivots a single precision tableau in place, like pivot_tableau
+ *
+ * tableau: struct to pivot
+ * pricing: pivot rule state, NULL for dantzig's rule
+ * result: filled with the pivot used
+ */
+void pivot_float_tableau(FloatTableau_t* tableau, Pricing_t* pricing, PivotResult_t* result) {
+    STATS_START(select_start);
+
+    // find pivot column
+    double min_value = -FLOAT_PRICE_TOLERANCE; // trying to find most negative number
+    int pivot_col = -1;
+
+    if (pricing != NULL && pricing->rule != RULE_DANTZIG) {
+        pivot_col = select_column(pricing, float_tableau_price, tableau, FLOAT_PRICE_TOLERANCE);
+    }
+    else {
+        float* objective_row = float_tableau_row(tableau, tableau->rows - 1);
+        for (int col = 0; col < tableau->cols - 1; col++) {
+            if (objective_row[col] < min_value) {
+                min_value = objective_row[col];
+                pivot_col = col;
+            }
+        }
+    }
+
+    result->pivot_col = pivot_col;
+    // bounds check for pivot column
+    if (pivot_col < 0) {
+        result->success = false;
+        return;
+    }
+
+    int pivot_row = float_ratio_test(tableau, pivot_col, tie_basis(pricing));
+
+    result->pivot_row = pivot_row;
+    // bounds check for pivot row
+    if (pivot_row < 0) {
+        result->success = false;
+        return;
+    }
+
+    STATS_CYCLES(select_cycles, select_start);
+    pivot_float_tableau_at(tableau, pivot_row, pivot_col);
+    if (pricing != NULL) update_float_tableau_pricing(pricing, tableau, pivot_row, pivot_col);
+    result->success = true;
+}
+
+/**
+ * Raises the degenerate right hand sides of a single precision tableau to
+ * distinct small values, so the rows stop tying in the ratio test. The
+ * objective entry follows the rows of the basic payoff columns.
+ *
+ * tableau: struct to perturb
+ * basis: column basic in each row
+ *
+ * return: if any right hand side was raised
+ */
+bool perturb_float_tableau(FloatTableau_t* tableau, const int* basis) {
+    int rhs = tableau->cols - 1;
+    float* objective_row = float_tableau_row(tableau, tableau->rows - 1);
+    bool perturbed = false;
+    for (int row = 0; row < tableau->s_size; row++) {
+        float* cur_row = float_tableau_row(tableau, row);
+        if (cur_row[rhs] > tableau->feasibility_tolerance) continue;
+
+        // steps of the golden ratio spread the rows over [1, 2)
+        double fraction = fmod(row * 0.6180339887498949, 1);
+        float value = (float) (FLOAT_PERTURBATION * (1 + fraction));
+        if (basis[row] < tableau->x_size) objective_row[rhs] += value - cur_row[rhs];
+        cur_row[rhs] = value;
+        perturbed = true;
+    }
+    return perturbed;
+}
+
+/**
+ * Recomputes the right hand side of a single precision tableau from its
+ * slack columns, which hold the inverse of the basis, so it is B^-1 1 again
+ * and any perturbation is gone. The objective entry is the sum of the duals.
+ *
+ * tableau: struct to restore
+ */
+void restore_float_tableau_rhs(FloatTableau_t* tableau) {
+    int rhs = tableau->cols - 1;
+    for (int row = 0; row < tableau->rows; row++) {
+        float* cur_row = float_tableau_row(tableau, row);
+        double sum = 0;
+        for (int col = tableau->x_size; col < rhs; col++) sum += cur_row[col];
+        cur_row[rhs] = (float) sum;
+    }
+}
+
+/**
+ * Chooses a dual simplex pivot for a single precision tableau whose
+ * objective row is nonnegative, like select_dual_pivot
+ *
+ * tableau: struct to choose the pivot of
+ * result: filled like select_dual_pivot
+ */
+void select_float_dual_pivot(FloatTableau_t* tableau, PivotResult_t* result) {
+    // find pivot row
+    double min_value = -tableau->feasibility_tolerance; // trying to find most negative number
+    int pivot_row = -1;
+
+    for (int row = 0; row < tableau->s_size; row++) {
+        double value = float_tableau_row(tableau, row)[tableau->cols - 1];
+        if (value < min_value) {
+            min_value = value;
+            pivot_row = row;
+        }
+    }
+
+    result->pivot_row = pivot_row;
+    result->pivot_col = -1;
+    result->success = false;
+    if (pivot_row < 0) return;
+
+    // find pivot column, the smallest ratio of objective entry to the
+    // magnitude of a negative pivot row entry
+    float* cur_row = float_tableau_row(tableau, pivot_row);
+    float* objective_row = float_tableau_row(tableau, tableau->rows - 1);
+    min_value = DBL_MAX; // finding smallest value
+    int pivot_col = -1;
+
+    for (int col = 0; col < tableau->cols - 1; col++) {
+        if (cur_row[col] >= -tableau->pivot_tolerance) continue;
+
+        double value = fmax(objective_row[col], 0) / -cur_row[col];
+        if (value < min_value) {
+            min_value = value;
+            pivot_col = col;
+        }
+    }
+
+    result->pivot_col = pivot_col;
+    result->success = pivot_col >= 0;
+}
+
+/**
+ * Runs a fraction free pivot over the rows of a 64-bit exact tableau,
+ * stopping at the first row with an entry that does not fit in 64 bits.
+ * Products are formed in 128 bits, so they cannot overflow, and the exact
+ * division by the denominator is a multiplication by its inverse modulo
+ * 2^64 once its factors of two are shifted out.
+ *
+ * tableau: struct to pivot, not widened
+ * pivot_row: row of the pivot
+ * pivot_col: col of the pivot
+ *
+ * return: row that overflowed, tableau->rows if none did
+ */
+int pivot_exact_rows(ExactTableau_t* tableau, int pivot_row, int pivot_col) {
+    int64_t* new_pivot_row = tableau->data + (size_t) pivot_row * tableau->stride;
+    int64_t pivot_value = new_pivot_row[pivot_col];
+    int64_t denominator = tableau->denominator;
+    int shift = __builtin_ctzll(denominator);
+    uint64_t inverse = inverse_uint64((uint64_t) (denominator >> shift));
+    __int128 bound = (__int128) denominator * INT64_MAX; // largest numerator whose quotient fits
+
+    for (int row = 0; row < tableau->rows; row++) {
+        if (row == pivot_row) continue;
+
+        int64_t* cur_row = tableau->data + (size_t) row * tableau->stride;
+        int64_t factor = cur_row[pivot_col];
+        if (factor == 0 && pivot_value == denominator) {
+            STATS_ADD(skipped_rows, 1);
+            continue;
+        }
+
+        // build the row in scratch, so it is untouched if it overflows
+        for (int col = 0; col < tableau->cols; col++) {
+            __int128 value = (__int128) pivot_value * cur_row[col] - (__int128) factor * new_pivot_row[col];
+            if (value > bound || value < -bound) return row;
+            tableau->scratch[col] = (int64_t) ((uint64_t) (value >> shift) * inverse);
+        }
+        memcpy(cur_row, tableau->scratch, tableau->cols * sizeof(int64_t));
+    }
+    return tableau->rows;
+}
+
+/**
+ * Runs a fraction free pivot over the rows of a widened exact tableau from a
+ * given row on. Everything is computed modulo 2^(64 * limbs), which is
+ * exact because every quotient fits, with room for the factors of two
+ * shifted out of the denominator.
+ *
+ * tableau: struct to pivot, widened
+ * pivot_row: row of the pivot
+ * pivot_col: col of the pivot
+ * start: first row to update
+ */
+void pivot_wide_exact_rows(ExactTableau_t* tableau, int pivot_row, int pivot_col, int start) {
+    int limbs = tableau->limbs;
+    uint64_t* denominator = tableau->work;
+    uint64_t* factor = denominator + limbs;
+    uint64_t* inverse = factor + limbs;
+    uint64_t* first = inverse + limbs;
+    uint64_t* second = first + limbs;
+    uint64_t* odd = second + limbs;
+    uint64_t* work = odd + limbs; // 2 * limbs, for the inverse
+
+    int shift = limbs_trailing_zeros(denominator, limbs);
+    memcpy(odd, denominator, limbs * sizeof(uint64_t));
+    limbs_shift_right(odd, shift, limbs);
+    limbs_inverse(inverse, odd, work, limbs);
+
+    uint64_t* pivot_value = exact_wide_entry(tableau, pivot_row, pivot_col);
+    bool unit = limbs_compare(pivot_value, denominator, limbs) == 0;
+    for (int row = start; row < tableau->rows; row++) {
+        if (row == pivot_row) continue;
+
+        memcpy(factor, exact_wide_entry(tableau, row, pivot_col), limbs * sizeof(uint64_t));
+        if (unit && limbs_zero(factor, limbs)) {
+            STATS_ADD(skipped_rows, 1);
+            continue;
+        }
+
+        for (int col = 0; col < tableau->cols; col++) {
+            uint64_t* entry = exact_wide_entry(tableau, row, col);
+            limbs_multiply(first, pivot_value, entry, limbs);
+            limbs_multiply(second, factor, exact_wide_entry(tableau, pivot_row, col), limbs);
+            limbs_subtract(first, second, limbs);
+            limbs_shift_right(first, shift, limbs);
+            limbs_multiply(entry, first, inverse, limbs);
+            limbs_sign_extend(entry, 64 * limbs - shift, limbs);
+        }
+    }
+}
+
+/**
+ * Widens an exact tableau if its entries might not fit with some bits to
+ * spare
+ *
+ * tableau: struct to check
+ * spare: bits needed beyond the bound on the entries and a sign bit
+ *
+ * return: false if that takes more than EXACT_MAX_LIMBS limbs, which sets
+ *         overflow
+ */
+bool reserve_exact_bits(ExactTableau_t* tableau, int spare) {
+    int limbs = (int) ceil((tableau->bound_bits + spare + 2) / 64);
+    if (limbs < 2) limbs = 2;
+    if (limbs <= tableau->limbs) return true;
+
+    if (limbs > EXACT_MAX_LIMBS) {
+        tableau->overflow = true;
+        return false;
+    }
+    widen_exact_tableau(tableau, limbs);
+    return true;
+}
+
+/**
+ * Pivots an exact tableau in place on a given entry, which must not be
+ * zero. A negative pivot element negates every entry after the pivot, which
+ * keeps the shared denominator positive.
+ *
+ * tableau: struct to pivot
+ * pivot_row: row of the pivot
+ * pivot_col: col of the pivot
+ *
+ * return: false if the entries outgrew EXACT_MAX_LIMBS limbs, which sets
+ *         overflow and leaves the tableau invalid
+ */
+bool pivot_exact_tableau_at(ExactTableau_t* tableau, int pivot_row, int pivot_col) {
+    int start = 0;
+    if (tableau->limbs == 0) {
+        start = pivot_exact_rows(tableau, pivot_row, pivot_col);
+        if (start == tableau->rows) {
+            int64_t pivot_value = tableau->data[(size_t) pivot_row * tableau->stride + pivot_col];
+            tableau->denominator = pivot_value;
+            if (pivot_value < 0) {
+                size_t size = (size_t) tableau->rows * tableau->stride;
+                for (size_t index = 0; index < size; index++) tableau->data[index] = -tableau->data[index];
+                tableau->denominator = -pivot_value;
+            }
+            return true;
+        }
+    }
+
+    // the low bits of the quotients are recovered above the denominator's
+    // factors of two, so those need room too
+    int shift = (tableau->limbs == 0)? __builtin_ctzll(tableau->denominator)
+                                     : limbs_trailing_zeros(tableau->work, tableau->limbs);
+    if (!reserve_exact_bits(tableau, shift)) return false;
+    pivot_wide_exact_rows(tableau, pivot_row, pivot_col, start);
+
+    int limbs = tableau->limbs;
+    memcpy(tableau->work, exact_wide_entry(tableau, pivot_row, pivot_col), limbs * sizeof(uint64_t));
+    if (limbs_negative(tableau->work, limbs)) {
+        size_t size = (size_t) tableau->rows * tableau->stride;
+        for (size_t index = 0; index < size; index++) limbs_negate(tableau->wide_data + index * limbs, limbs);
+        limbs_negate(tableau->work, limbs);
+    }
+    return true;
+}
+
+/**
+ * Compares the ratio test ratios of two rows of an exact tableau exactly, by
+ * cross multiplying. The shared denominator cancels.
+ *
+ * tableau: struct to compare in
+ * row: row to compare, with a positive entry in pivot_col
+ * best: row to compare against, with a positive entry in pivot_col
+ * pivot_col: entering column
+ *
+ * return: if row has the smaller ratio
+ */
+bool exact_ratio_below(ExactTableau_t* tableau, int row, int best, int pivot_col) {
+    int rhs = tableau->cols - 1;
+    if (tableau->limbs == 0) {
+        int64_t* cur_row = tableau->data + (size_t) row * tableau->stride;
+        int64_t* best_row = tableau->data + (size_t) best * tableau->stride;
+        return (__int128) cur_row[rhs] * best_row[pivot_col] < (__int128) best_row[rhs] * cur_row[pivot_col];
+    }
+
+    // right hand sides are nonnegative in a feasible tableau
+    int limbs = tableau->limbs;
+    uint64_t* first = tableau->work + limbs;
+    uint64_t* second = first + 2 * limbs;
+    limbs_multiply_full(first, exact_wide_entry(tableau, row, rhs), exact_wide_entry(tableau, best, pivot_col), limbs);
+    limbs_multiply_full(second, exact_wide_entry(tableau, best, rhs), exact_wide_entry(tableau, row, pivot_col), limbs);
+    for (int limb = 2 * limbs - 1; limb >= 0; limb--) {
+        if (first[limb] != second[limb]) return first[limb] < second[limb];
+    }
+    return false;
+}
+
+/**
+ * Checks the sign of an entry of an exact tableau
+ *
+ * tableau: struct to index
+ * row: row index
+ * col: column index
+ *
+ * return: -1, 0 or 1 as the entry is negative, zero or positive
+ */
+int exact_sign(ExactTableau_t* tableau, int row, int col) {
+    if (tableau->limbs == 0) {
+        int64_t value = tableau->data[(size_t) row * tableau->stride + col];
+        return (value > 0) - (value < 0);
+    }
+
+    uint64_t* value = exact_wide_entry(tableau, row, col);
+    if (limbs_negative(value, tableau->limbs)) return -1;
+    return !limbs_zero(value, tableau->limbs);
+}
+
+/**
+ * Pivots an exact tableau in place, like pivot_tableau. Every comparison is
+ * exact, so degenerate rows with a zero ratio are allowed to leave.
+ *
+ * tableau: struct to pivot
+ * pricing: pivot rule state, NULL for dantzig's rule
+ * result: filled with the pivot used, success is false with both indices
+ *         set when the pivot overflowed
+ */
+void pivot_exact_tableau(ExactTableau_t* tableau, Pricing_t* pricing, PivotResult_t* result) {
+    STATS_START(select_start);
+
+    // find pivot column, the shared denominator is positive so the reduced
+    // costs compare like their numerators
+    int pivot_col = -1;
+    int objective = tableau->rows - 1;
+    if (pricing != NULL && pricing->rule != RULE_DANTZIG) {
+        pivot_col = select_column(pricing, exact_tableau_price, tableau, 0);
+    }
+    else if (tableau->limbs == 0) {
+        int64_t* objective_row = tableau->data + (size_t) objective * tableau->stride;
+        int64_t min_value = 0; // trying to find most negative number
+        for (int col = 0; col < tableau->cols - 1; col++) {
+            if (objective_row[col] < min_value) {
+                min_value = objective_row[col];
+                pivot_col = col;
+            }
+        }
+    }
+    else {
+        for (int col = 0; col < tableau->cols - 1; col++) {
+            if (exact_sign(tableau, objective, col) >= 0) continue;
+            if (pivot_col < 0 || limbs_compare(exact_wide_entry(tableau, objective, col),
+                                               exact_wide_entry(tableau, objective, pivot_col), tableau->limbs) < 0)
+                pivot_col = col;
+        }
+    }
+
+    result->pivot_col = pivot_col;
+    // bounds check for pivot column
+    if (pivot_col < 0) {
+        result->success = false;
+        return;
+    }
+
+    // find pivot row, ties going to the lowest basic column under bland's rule
+    const int* basis = tie_basis(pricing);
+    int pivot_row = -1;
+    for (int row = 0; row < tableau->s_size; row++) {
+        if (exact_sign(tableau, row, pivot_col) <= 0) continue;
+        if (pivot_row < 0 || exact_ratio_below(tableau, row, pivot_row, pivot_col)) pivot_row = row;
+        else if (basis != NULL && basis[row] < basis[pivot_row] && !exact_ratio_below(tableau, pivot_row, row, pivot_col))
+            pivot_row = row;
+    }
+
+    result->pivot_row = pivot_row;
+    // bounds check for pivot row
+    if (pivot_row < 0) {
+        result->success = false;
+        return;
+    }
+
+    STATS_CYCLES(select_cycles, select_start);
+    STATS_START(eliminate_start);
+    result->success = pivot_exact_tableau_at(tableau, pivot_row, pivot_col);
+    STATS_CYCLES(eliminate_cycles, eliminate_start);
+    if (result->success && pricing != NULL) update_exact_tableau_pricing(pricing, tableau, pivot_row, pivot_col);
+}
+
+/**
+ * Chooses a dual simplex pivot for a tableau whose objective row is
+ * nonnegative, which keeps it nonnegative. The leaving row has the most
+ * negative right hand side and the entering column passes the dual ratio
+ * test. The tableau is not changed.
+ *
+ * tableau: struct to choose the pivot of
+ * result: filled with the pivot chosen. On failure pivot_row is -1 when the
+ *         tableau is feasible, and pivot_col is -1 when the leaving row has
+ *         no negative entry, so the linear program is infeasible.
+ */
+void select_dual_pivot(Tableau_t* tableau, PivotResult_t* result) {
+    // find pivot row
+    double min_value = -tableau->feasibility_tolerance; // trying to find most negative number
+    int pivot_row = -1;
+
+    for (int row = 0; row < tableau->s_size; row++) {
+        double value = tableau->m[row][tableau->cols - 1];
+        if (value < min_value) {
+            min_value = value;
+            pivot_row = row;
+        }
+    }
+
+    result->pivot_row = pivot_row;
+    result->pivot_col = -1;
+    result->success = false;
+    if (pivot_row < 0) return;
+
+    // find pivot column, the smallest ratio of objective entry to the
+    // magnitude of a negative pivot row entry
+    double* cur_row = tableau->m[pivot_row];
+    double* objective_row = tableau->m[tableau->rows - 1];
+    min_value = DBL_MAX; // finding smallest value
+    int pivot_col = -1;
+
+    for (int col = 0; col < tableau->cols - 1; col++) {
+        if (cur_row[col] >= -tableau->pivot_tolerance) continue;
+
+        double value = fmax(objective_row[col], 0) / -cur_row[col];
+        if (value < min_value) {
+            min_value = value;
+            pivot_col = col;
+        }
+    }
+
+    result->pivot_col = pivot_col;
+    result->success = pivot_col >= 0;
+}
+
+/**
+ * Changes the shift of a tableau in place, as if it was built with the new
+ * shift and pivoted to the same basis. Adding d to every payoff entry is a
+ * rank one change of the basis, and working it through gives each
+ * constraint row minus d beta_i / (1 + d V) times the objective row, where
+ * beta is the right hand side and V its objective entry, and the objective
+ * row divided by 1 + d V. An optimal basis stays optimal, since the optimal
+ * strategies of a game do not depend on the shift.
+ *
+ * tableau: struct to shift
+ * k: new shift, at least the current one
+ */
+void shift_tableau(Tableau_t* tableau, double k) {
+    double d = k - tableau->k;
+    double* objective_row = tableau->m[tableau->rows - 1];
+    double scale = 1 + d * objective_row[tableau->cols - 1];
+
+    for (int row = 0; row < tableau->s_size; row++) {
+        double factor = d * tableau->m[row][tableau->cols - 1] / scale;
+        if (factor != 0) eliminate_row(tableau->m[row], objective_row, factor, tableau->stride);
+    }
+    for (int col = 0; col < tableau->cols; col++) objective_row[col] /= scale;
+    tableau->k = k;
+}
+
+/**
+ * Adds a payoff column to a tableau as a new nonbasic x variable, after the
+ * existing ones. Its entries in terms of the current basis are the slack
+ * columns, which hold the inverse of the basis, times the shifted column.
+ *
+ * tableau: struct to append to
+ * column: payoff of the new column against each row, s_size entries
+ */
+void append_tableau_column(Tableau_t* tableau, const double* column) {
+    int m = tableau->s_size;
+    int n = tableau->x_size;
+    int old_cols = tableau->cols;
+    grow_tableau(tableau, tableau->rows, old_cols + 1);
+
+    for (int row = 0; row < tableau->rows; row++) {
+        double* cur_row = tableau->m[row];
+        double value = (row == m)? -1 : 0; // objective coefficient of x
+        for (int slack = 0; slack < m; slack++) value += cur_row[n + slack] * (column[slack] + tableau->k);
+
+        memmove(cur_row + n + 1, cur_row + n, (old_cols - n) * sizeof(double));
+        cur_row[n] = value;
+    }
+    tableau->x_size++;
+}
+
+/**
+ * Adds a payoff row to a tableau as a new constraint whose slack is basic,
+ * before the objective row. The row is reduced by the rows of the basic
+ * columns so it is in terms of the current basis.
+ *
+ * tableau: struct to append to
+ * basis: column basic in each existing row
+ * payoff_row: payoff of the new row against each column, x_size entries
+ */
+void append_tableau_row(Tableau_t* tableau, const int* basis, const double* payoff_row) {
+    int m = tableau->s_size;
+    int n = tableau->x_size;
+    int old_cols = tableau->cols;
+    grow_tableau(tableau, tableau->rows + 1, old_cols + 1);
+
+    // the new slack goes just before the right hand side, and the objective
+    // row moves down to make room for the new row
+    for (int row = 0; row <= m; row++) {
+        double* cur_row = tableau->m[row];
+        cur_row[old_cols] = cur_row[old_cols - 1];
+        cur_row[old_cols - 1] = 0;
+    }
+    memcpy(tableau->m[m + 1], tableau->m[m], tableau->stride * sizeof(double));
+
+    double* new_row = tableau->m[m];
+    memset(new_row, 0, tableau->stride * sizeof(double));
+    for (int col = 0; col < n; col++) new_row[col] = payoff_row[col] + tableau->k;
+    new_row[n + m] = 1;
+    new_row[old_cols] = 1;
+
+    for (int row = 0; row < m; row++) {
+        double factor = new_row[basis[row]];
+        if (factor != 0) eliminate_row(new_row, tableau->m[row], factor, tableau->stride);
+    }
+    tableau->s_size++;
+}
+
+/**
+ * Struct for a persistent pool of threads that pivot a tableau together.
+ * The calling thread takes part as thread 0, so a pool of n threads starts
+ * n - 1 workers.
+ *
+ * threads: number of threads pivoting, including the caller
+ * workers: handles of the started worker threads
+ * barrier: synchronizes every phase of a pivot
+ * stop: tells the workers to exit
+ * tableau: tableau being pivoted, NULL if float_tableau is
+ * float_tableau: single precision tableau being pivoted, NULL if tableau is
+ * fixed_col: pivot column chosen before the pivot, -1 to scan for it
+ * fixed_row: pivot row chosen before the pivot, -1 for the ratio test
+ * basis: column basic in each row, breaking ratio test ties for Bland's
+ *        rule, NULL otherwise
+ * factors: pivot column of the tableau saved before the update
+ * capacity: number of entries factors can hold
+ * col_value: most negative objective entry found by each thread
+ * col_index: column of col_value, -1 if none was found
+ * bound_value: first pass of the ratio test over each thread's rows
+ * row_value: score of the row chosen by each thread, see harris_select
+ * row_index: row of row_value, -1 if none was found
+ * pivot_row: row of the pivot, -1 if none was found
+ * pivot_col: col of the pivot, -1 if none was found
+ * span_count: runs of the pivot row listed in the tableau's spans, 0 to
+ *             update whole rows
+ */
+struct PivotPool {
+    int threads;
+    pthread_t* workers;
+    pthread_barrier_t barrier;
+    bool stop;
+    Tableau_t* tableau;
+    FloatTableau_t* float_tableau;
+    int fixed_col;
+    int fixed_row;
+    const int* basis;
+    double* factors;
+    int capacity;
+    double* col_value;
+    int* col_index;
+    RatioBounds_t* bound_value;
+    double* row_value;
+    int* row_index;
+    int pivot_row;
+    int pivot_col;
+    int span_count;
+};
+typedef struct PivotPool PivotPool_t;
+
+/**
+ * Struct for handing a worker its pool
+ *
+ * pool: pool the worker belongs to
+ * id: index of the worker's row and column blocks
+ */
+struct PivotWorker {
+    PivotPool_t* pool;
+    int id;
+};
+typedef struct PivotWorker PivotWorker_t;
+
+/**
+ * Finds the contiguous block of a range owned by one thread
+ *
+ * count: length of the range
+ * parts: number of blocks
+ * index: block to find
+ * start: set to the first index of the block
+ * end: set to one past the last index of the block
+ */
+void block_range(int count, int parts, int index, int* start, int* end) {
+    *start = (int) ((long) count * index / parts);
+    *end = (int) ((long) count * (index + 1) / parts);
+}
+
+/**
+ * Combines the per-thread scan results in thread order. Ties go to the
+ * earliest thread, which matches the serial scan picking the first index.
+ *
+ * values: best value found by each thread
+ * indices: index of each value, -1 if the thread found none
+ * threads: number of threads
+ * init: value a partial result has to beat
+ *
+ * return: index of the best partial result, -1 if none
+ */
+int reduce_partials(double* values, int* indices, int threads, double init) {
+    double best = init;
+    int index = -1;
+
+    for (int thread = 0; thread < threads; thread++) {
+        if (indices[thread] >= 0 && values[thread] < best) {
+            best = values[thread];
+            index = indices[thread];
+        }
+    }
+
+    return index;
+}
+
+/**
+ * Combines the per-thread first passes of the ratio test
+ *
+ * bounds: first pass of each thread
+ * threads: number of threads
+ * bound: filled with the first pass over every thread's rows
+ */
+void reduce_bounds(const RatioBounds_t* bounds, int threads, RatioBounds_t* bound) {
+    *bound = bounds[0];
+    for (int thread = 1; thread < threads; thread++) merge_ratio_bounds(bound, &bounds[thread]);
+}
+
+/**
+ * Runs one thread's share of a pivot. Every thread computes the same
+ * reductions, so they all agree on the pivot without extra signalling.
+ *
+ * pool: pool doing the pivot
+ * id: index of this thread
+ */
+void pivot_block(PivotPool_t* pool, int id) {
+    Tableau_t* tableau = pool->tableau;
+    int col_start, col_end, row_start, row_end;
+    STATS_START(select_start);
+    block_range(tableau->cols, pool->threads, id, &col_start, &col_end);
+    block_range(tableau->rows, pool->threads, id, &row_start, &row_end);
+
+    // find pivot column over this thread's columns, unless a pivot rule
+    // already chose it
+    double min_value = 0; // trying to find most negative number
+    int pivot_col = pool->fixed_col;
+
+    if (pivot_col < 0) {
+        double* objective_row = tableau_row(tableau, tableau->rows - 1);
+        for (int col = col_start; col < col_end; col++) {
+            if (objective_row[col] < min_value) {
+                min_value = objective_row[col];
+                pivot_col = col;
+            }
+        }
+
+        pool->col_value[id] = min_value;
+        pool->col_index[id] = pivot_col;
+        pthread_barrier_wait(&pool->barrier);
+
+        pivot_col = reduce_partials(pool->col_value, pool->col_index, pool->threads, 0);
+        if (pivot_col < 0) {
+            if (id == 0) pool->pivot_col = pool->pivot_row = -1;
+            return;
+        }
+    }
+
+    // find pivot row over this thread's rows, saving the pivot column, unless
+    // the caller already chose it. both passes of the ratio test run over
+    // every thread's rows, the second within the smallest bound of the first
+    for (int row = row_start; row < row_end; row++)
+        pool->factors[row] = tableau_row(tableau, row)[pivot_col];
+
+    int pivot_row = pool->fixed_row;
+    if (pivot_row < 0) {
+        harris_bound(tableau, pivot_col, row_start, row_end, &pool->bound_value[id]);
+        pthread_barrier_wait(&pool->barrier);
+
+        RatioBounds_t bounds;
+        reduce_bounds(pool->bound_value, pool->threads, &bounds);
+        pool->row_index[id] = harris_select(tableau, pivot_col, row_start, row_end, &bounds, pool->basis,
+                                            &pool->row_value[id]);
+    }
+    pthread_barrier_wait(&pool->barrier);
+
+    if (pivot_row < 0) pivot_row = reduce_partials(pool->row_value, pool->row_index, pool->threads, DBL_MAX);
+    if (id == 0) {
+        pool->pivot_col = pivot_col;
+        pool->pivot_row = pivot_row;
+    }
+    if (pivot_row < 0) return;
+    STATS_CYCLES(select_cycles, select_start);
+    STATS_START(eliminate_start);
+
+    // update this thread's columns of the pivot row
+    double* new_pivot_row = tableau_row(tableau, pivot_row);
+    double pivot_value = pool->factors[pivot_row];
+    for (int col = col_start; col < col_end; col++)
+        new_pivot_row[col] = new_pivot_row[col] / pivot_value;
+
+    pthread_barrier_wait(&pool->barrier);
+    if (id == 0) pool->span_count = list_pivot_spans(tableau, new_pivot_row);
+    pthread_barrier_wait(&pool->barrier);
+
+    // update this thread's other rows
+    for (int row = row_start; row < row_end; row++) {
+        stream_tableau_panel(tableau, row, row_start, row_end);
+        if (row == pivot_row || pool->factors[row] == 0) continue;
+        double* cur_row = tableau_row(tableau, row);
+        if (pool->span_count > 0) eliminate_spans(cur_row, new_pivot_row, pool->factors[row], tableau->spans, pool->span_count);
+        else eliminate_row(cur_row, new_pivot_row, pool->factors[row], tableau->stride);
+    }
+    STATS_CYCLES(eliminate_cycles, eliminate_start);
+}
+
+/**
+ * Runs one thread's share of a pivot of a single precision tableau, in the
+ * same phases as pivot_block
+ *
+ * pool: pool doing the pivot
+ * id: index of this thread
+ */
+void pivot_float_block(PivotPool_t* pool, int id) {
+    FloatTableau_t* tableau = pool->float_tableau;
+    int col_start, col_end, row_start, row_end;
+    STATS_START(select_start);
+    block_range(tableau->cols, pool->threads, id, &col_start, &col_end);
+    block_range(tableau->rows, pool->threads, id, &row_start, &row_end);
+
+    // find pivot column over this thread's columns, unless a pivot rule
+    // already chose it
+    int pivot_col = pool->fixed_col;
+    if (pivot_col < 0) {
+        double min_value = -FLOAT_PRICE_TOLERANCE; // trying to find most negative number
+        float* objective_row = float_tableau_row(tableau, tableau->rows - 1);
+        for (int col = col_start; col < col_end && col < tableau->cols - 1; col++) {
+            if (objective_row[col] < min_value) {
+                min_value = objective_row[col];
+                pivot_col = col;
+            }
+        }
+
+        pool->col_value[id] = min_value;
+        pool->col_index[id] = pivot_col;
+        pthread_barrier_wait(&pool->barrier);
+
+        pivot_col = reduce_partials(pool->col_value, pool->col_index, pool->threads, 0);
+        if (pivot_col < 0) {
+            if (id == 0) pool->pivot_col = pool->pivot_row = -1;
+            return;
+        }
+    }
+
+    // find pivot row over this thread's rows, saving the pivot column, unless
+    // the caller already chose it
+    for (int row = row_start; row < row_end; row++)
+        pool->factors[row] = float_tableau_row(tableau, row)[pivot_col];
+
+    int pivot_row = pool->fixed_row;
+    if (pivot_row < 0) {
+        float_harris_bound(tableau, pivot_col, row_start, row_end, &pool->bound_value[id]);
+        pthread_barrier_wait(&pool->barrier);
+
+        RatioBounds_t bounds;
+        reduce_bounds(pool->bound_value, pool->threads, &bounds);
+        pool->row_index[id] = float_harris_select(tableau, pivot_col, row_start, row_end, &bounds, pool->basis,
+                                                  &pool->row_value[id]);
+    }
+    pthread_barrier_wait(&pool->barrier);
+
+    if (pivot_row < 0) pivot_row = reduce_partials(pool->row_value, pool->row_index, pool->threads, DBL_MAX);
+    if (id == 0) {
+        pool->pivot_col = pivot_col;
+        pool->pivot_row = pivot_row;
+    }
+    if (pivot_row < 0) return;
+    STATS_CYCLES(select_cycles, select_start);
+    STATS_START(eliminate_start);
+
+    // update this thread's columns of the pivot row
+    float* new_pivot_row = float_tableau_row(tableau, pivot_row);
+    float pivot_value = (float) pool->factors[pivot_row];
+    for (int col = col_start; col < col_end; col++)
+        new_pivot_row[col] = new_pivot_row[col] / pivot_value;
+
+    pthread_barrier_wait(&pool->barrier);
+    if (id == 0) pool->span_count = list_float_pivot_spans(tableau, new_pivot_row);
+    pthread_barrier_wait(&pool->barrier);
+
+    // update this thread's other rows
+    for (int row = row_start; row < row_end; row++) {
+        if (row == pivot_row || pool->factors[row] == 0) continue;
+        float* cur_row = float_tableau_row(tableau, row);
+        if (pool->span_count > 0) eliminate_float_spans(cur_row, new_pivot_row, (float) pool->factors[row], tableau->spans, pool->span_count);
+        else eliminate_float_row(cur_row, new_pivot_row, (float) pool->factors[row], tableau->stride);
+    }
+    STATS_CYCLES(eliminate_cycles, eliminate_start);
+}
+
+/**
+ * Main loop of a pool worker thread
+ *
+ * arg: the worker's PivotWorker struct
+ *
+ * return: NULL
+ */
+void* pivot_worker(void* arg) {
+    PivotWorker_t* worker = (PivotWorker_t*) arg;
+    PivotPool_t* pool = worker->pool;
+
+    while (true) {
+        pthread_barrier_wait(&pool->barrier); // wait for a tableau
+        if (pool->stop) break;
+
+        if (pool->float_tableau != NULL) pivot_float_block(pool, worker->id);
+        else pivot_block(pool, worker->id);
+        pthread_barrier_wait(&pool->barrier); // signal pivot is done
+    }
+
+    free(worker);
+    return NULL;
+}
+
+/**
+ * Starts a pool of threads for pivoting
+ *
+ * threads: number of threads including the caller
+ *
+ * return: started pool
+ */
+PivotPool_t* create_pivot_pool(int threads) {
+    PivotPool_t* pool = (PivotPool_t*) malloc(sizeof(PivotPool_t));
+    pool->threads = threads;
+    pool->stop = false;
+    pool->tableau = NULL;
+    pool->float_tableau = NULL;
+    pool->fixed_col = -1;
+    pool->fixed_row = -1;
+    pool->basis = NULL;
+    pool->factors = NULL;
+    pool->capacity = 0;
+    pool->span_count = 0;
+    pool->col_value = (double*) calloc(threads, sizeof(double));
+    pool->col_index = (int*) calloc(threads, sizeof(int));
+    pool->bound_value = (RatioBounds_t*) calloc(threads, sizeof(RatioBounds_t));
+    pool->row_value = (double*) calloc(threads, sizeof(double));
+    pool->row_index = (int*) calloc(threads, sizeof(int));
+    pthread_barrier_init(&pool->barrier, NULL, threads);
+
+    pool->workers = (pthread_t*) calloc(threads, sizeof(pthread_t));
+    for (int id = 1; id < threads; id++) {
+        PivotWorker_t* worker = (PivotWorker_t*) malloc(sizeof(PivotWorker_t));
+        worker->pool = pool;
+        worker->id = id;
+        pthread_create(&pool->workers[id], NULL, pivot_worker, worker);
+    }
+
+    return pool;
+}
+
+/**
+ * Stops the workers of a pool and frees it
+ *
+ * pool: pool to free
+ */
+void free_pivot_pool(PivotPool_t* pool) {
+    pool->stop = true;
+    pthread_barrier_wait(&pool->barrier);
+    for (int id = 1; id < pool->threads; id++)
+        pthread_join(pool->workers[id], NULL);
+
+    pthread_barrier_destroy(&pool->barrier);
+    free(pool->workers);
+    free(pool->factors);
+    free(pool->col_value);
+    free(pool->col_index);
+    free(pool->bound_value);
+    free(pool->row_value);
+    free(pool->row_index);
+    free(pool);
+}
+
+/**
+ * Runs one pivot of a tableau on every thread of a pool, with the fixed
+ * column and row already set. Exactly one of the tableaus is given.
+ *
+ * pool: pool to pivot with
+ * tableau: struct to pivot, NULL if float_tableau is given
+ * float_tableau: single precision struct to pivot, NULL if tableau is given
+ */
+void run_pivot_pool(PivotPool_t* pool, Tableau_t* tableau, FloatTableau_t* float_tableau) {
+    // the pivot column buffer only grows, so steady state pivots do not allocate
+    int rows = (tableau != NULL)? tableau->rows : float_tableau->rows;
+    if (pool->capacity < rows) {
+        free(pool->factors);
+        pool->factors = (double*) calloc(rows, sizeof(double));
+        pool->capacity = rows;
+    }
+
+    pool->tableau = tableau;
+    pool->float_tableau = float_tableau;
+    pthread_barrier_wait(&pool->barrier); // release workers
+    if (float_tableau != NULL) pivot_float_block(pool, 0);
+    else pivot_block(pool, 0);
+    pthread_barrier_wait(&pool->barrier); // wait for workers
+
+#ifdef SIMPLEX_STATS
+    // only this thread counts, so it counts the rows every thread skipped
+    if (pool->pivot_row >= 0) {
+        for (int row = 0; row < rows; row++) STATS_ADD(skipped_rows, row != pool->pivot_row && pool->factors[row] == 0);
+    }
+#endif
+}
+
+/**
+ * Pivots the provided tableau in place using every thread of the pool. The
+ * pivot chosen and the resulting tableau are identical to pivot_tableau.
+ *
+ * pool: pool to pivot with
+ * tableau: struct to pivot
+ * pricing: pivot rule state, NULL for dantzig's rule
+ * result: filled with the pivot used
+ */
+void pool_pivot_tableau(PivotPool_t* pool, Tableau_t* tableau, Pricing_t* pricing, PivotResult_t* result) {
+    // rules other than dantzig's choose the column before the workers start
+    pool->fixed_col = -1;
+    pool->fixed_row = -1;
+    pool->basis = tie_basis(pricing);
+    STATS_START(select_start);
+    if (pricing != NULL && pricing->rule != RULE_DANTZIG) {
+        pool->fixed_col = select_column(pricing, tableau_price, tableau, 0);
+        if (pool->fixed_col < 0) {
+            result->pivot_col = -1;
+            result->success = false;
+            return;
+        }
+    }
+    STATS_CYCLES(select_cycles, select_start);
+
+    run_pivot_pool(pool, tableau, NULL);
+    result->pivot_col = pool->pivot_col;
+    result->pivot_row = pool->pivot_row;
+    result->success = pool->pivot_col >= 0 && pool->pivot_row >= 0;
+    if (result->success && pricing != NULL) update_tableau_pricing(pricing, tableau, result->pivot_row, result->pivot_col);
+}
+
+/**
+ * Pivots a tableau in place on a given entry using every thread of the pool,
+ * with the same result as pivot_tableau_at
+ *
+ * pool: pool to pivot with
+ * tableau: struct to pivot
+ * pivot_row: row of the pivot
+ * pivot_col: col of the pivot
+ */
+void pool_pivot_tableau_at(PivotPool_t* pool, Tableau_t* tableau, int pivot_row, int pivot_col) {
+    pool->fixed_col = pivot_col;
+    pool->fixed_row = pivot_row;
+    run_pivot_pool(pool, tableau, NULL);
+}
+
+/**
+ * Pivots a single precision tableau in place using every thread of the
+ * pool, with the same pivot and result as pivot_float_tableau
+ *
+ * pool: pool to pivot with
+ * tableau: struct to pivot
+ * pricing: pivot rule state, NULL for dantzig's rule
+ * result: filled with the pivot used
+ */
+void pool_pivot_float_tableau(PivotPool_t* pool, FloatTableau_t* tableau, Pricing_t* pricing, PivotResult_t* result) {
+    pool->fixed_col = -1;
+    pool->fixed_row = -1;
+    pool->basis = tie_basis(pricing);
+    STATS_START(select_start);
+    if (pricing != NULL && pricing->rule != RULE_DANTZIG) {
+        pool->fixed_col = select_column(pricing, float_tableau_price, tableau, FLOAT_PRICE_TOLERANCE);
+        if (pool->fixed_col < 0) {
+            result->pivot_col = -1;
+            result->success = false;
+            return;
+        }
+    }
+    STATS_CYCLES(select_cycles, select_start);
+
+    run_pivot_pool(pool, NULL, tableau);
+    result->pivot_col = pool->pivot_col;
+    result->pivot_row = pool->pivot_row;
+    result->success = pool->pivot_col >= 0 && pool->pivot_row >= 0;
+    if (result->success && pricing != NULL) update_float_tableau_pricing(pricing, tableau, result->pivot_row, result->pivot_col);
+}
+
+/**
+ * Pivots a single precision tableau in place on a given entry using every
+ * thread of the pool, with the same result as pivot_float_tableau_at
+ *
+ * pool: pool to pivot with
+ * tableau: struct to pivot
+ * pivot_row: row of the pivot
+ * pivot_col: col of the pivot
+ */
+void pool_pivot_float_tableau_at(PivotPool_t* pool, FloatTableau_t* tableau, int pivot_row, int pivot_col) {
+    pool->fixed_col = pivot_col;
+    pool->fixed_row = pivot_row;
+    run_pivot_pool(pool, NULL, tableau);
+}
+
+/**
+ * Struct for pivoting a tableau with most of each pivot's update deferred.
+ * The deferred updates are applied to a tile of columns of every row at a
+ * time, so the tableau streams through memory once per depth pivots rather
+ * than once per pivot. Until then the tableau holds the entries from before
+ * the deferred pivots, except for the objective row, the right hand side,
+ * and the rows and columns that pivoted, which are kept up to date to choose
+ * the next pivots. Deferred pivot k still owes row i the update
+ * row -= factors[i * depth + k] * pivot_rows[k].
+ *
+ * depth: number of pivots deferred before they are applied
+ * count: number of pivots deferred so far
+ * stride: distance between the rows of pivot_rows, that of the tableau
+ * factors: entry of each row in the pivot column of each deferred pivot,
+ *          depth per row, 0 once the row is up to date
+ * pivot_rows: scaled pivot row of each deferred pivot, 0 in the columns that
+ *             are up to date
+ * factor_capacity: number of doubles allocated for factors
+ * row_capacity: number of doubles allocated for pivot_rows
+ */
+struct BlockedPivots {
+    int depth;
+    int count;
+    int stride;
+    double* factors;
+    double* pivot_rows;
+    size_t factor_capacity;
+    size_t row_capacity;
+};
+typedef struct BlockedPivots BlockedPivots_t;
+
+/**
+ * Creates an empty struct for blocked pivots, sized by reset_blocked_pivots
+ *
+ * return: struct, free with free_blocked_pivots
+ */
+BlockedPivots_t* create_blocked_pivots() {
+    return (BlockedPivots_t*) calloc(1, sizeof(BlockedPivots_t));
+}
+
+/**
+ * Frees a blocked pivots struct and its buffers
+ *
+ * blocked: struct to free
+ */
+void free_blocked_pivots(BlockedPivots_t* blocked) {
+    free(blocked->factors);
+    free(blocked->pivot_rows);
+    free(blocked);
+}
+
+/**
+ * Starts blocked pivots of a tableau with no pivot deferred, growing the
+ * buffers when they are too small for it
+ *
+ * blocked: struct to reset
+ * tableau: tableau to pivot
+ * depth: number of pivots to defer before applying them
+ */
+void reset_blocked_pivots(BlockedPivots_t* blocked, Tableau_t* tableau, int depth) {
+    size_t factor_size = (size_t) tableau->rows * depth;
+    if (factor_size > blocked->factor_capacity) {
+        free(blocked->factors);
+        blocked->factors = (double*) malloc(factor_size * sizeof(double));
+        blocked->factor_capacity = factor_size;
+    }
+
+    size_t row_size = (size_t) depth * tableau->stride;
+    if (row_size > blocked->row_capacity) {
+        free(blocked->pivot_rows);
+        blocked->pivot_rows = (double*) aligned_alloc(TABLEAU_ALIGN, row_size * sizeof(double));
+        blocked->row_capacity = row_size;
+    }
+
+    blocked->depth = depth;
+    blocked->count = 0;
+    blocked->stride = tableau->stride;
+}
+
+/**
+ * Updates one entry like eliminate_row, rounding like the kernel in use so
+ * blocked pivots reach the same tableau as pivot_tableau_at
+ *
+ * entry: entry to update
+ * factor: entry of its row in the pivot column
+ * value: entry of the scaled pivot row in its column
+ *
+ * return: updated entry
+ */
+static inline double eliminate_entry(double entry, double factor, double value) {
+    return (eliminate_row == eliminate_row_scalar)? entry - (factor * value) : fma(-factor, value, entry);
+}
+
+/**
+ * Applies every deferred pivot to a tableau, a tile of columns at a time.
+ * A tile of each deferred pivot row stays in cache while every row's tile
+ * is updated by all of them in turn. A streamed tableau is tiled a panel of
+ * rows at a time, so it is read from its file once per flush.
+ *
+ * blocked: deferred pivots to apply, none are left afterwards
+ * tableau: tableau the pivots were deferred on
+ */
+void flush_blocked_pivots(BlockedPivots_t* blocked, Tableau_t* tableau) {
+    int count = blocked->count;
+    int depth = blocked->depth;
+    int tile = BLOCK_TILE_ENTRIES / depth / TABLEAU_PAD * TABLEAU_PAD;
+    if (tile < TABLEAU_PAD) tile = TABLEAU_PAD;
+    int panel = (tableau->streamed)? tableau_panel_rows(tableau) : tableau->s_size;
+
+    for (int first = 0; count > 0 && first < tableau->s_size; first += panel) {
+        int last = (tableau->s_size - first < panel)? tableau->s_size : first + panel;
+        stream_tableau_panel(tableau, first, 0, tableau->s_size);
+        for (int start = 0; start < tableau->stride; start += tile) {
+            int length = (tableau->stride - start < tile)? tableau->stride - start : tile;
+            for (int row = first; row < last; row++) {
+                double* cur_row = tableau_row(tableau, row) + start;
+                double* factors = blocked->factors + (size_t) row * depth;
+                for (int pivot = 0; pivot < count; pivot++) {
+                    if (factors[pivot] == 0) continue;
+                    eliminate_row(cur_row, blocked->pivot_rows + (size_t) pivot * blocked->stride + start, factors[pivot], length);
+                }
+            }
+        }
+    }
+    blocked->count = 0;
+}
+
+/**
+ * Brings a column of a tableau with deferred pivots up to date, so the
+ * deferred pivots no longer owe it anything
+ *
+ * blocked: deferred pivots
+ * tableau: tableau the pivots were deferred on
+ * col: column to update
+ */
+void refresh_blocked_column(BlockedPivots_t* blocked, Tableau_t* tableau, int col) {
+    int count = blocked->count;
+    int depth = blocked->depth;
+    if (count == 0) return;
+
+    for (int row = 0; row < tableau->s_size; row++) {
+        double* entry = tableau_row(tableau, row) + col;
+        double* factors = blocked->factors + (size_t) row * depth;
+        for (int pivot = 0; pivot < count; pivot++) {
+            if (factors[pivot] != 0) *entry = eliminate_entry(*entry, factors[pivot], blocked->pivot_rows[(size_t) pivot * blocked->stride + col]);
+        }
+    }
+    for (int pivot = 0; pivot < count; pivot++) blocked->pivot_rows[(size_t) pivot * blocked->stride + col] = 0;
+}
+
+/**
+ * Pivots a tableau on a given entry, whose column is up to date, deferring
+ * the update of the other rows. The pivot row is brought up to date and
+ * scaled, and the objective row and right hand side are updated now, which
+ * is all choosing the next pivot needs.
+ *
+ * blocked: deferred pivots, applied once depth of them are deferred
+ * tableau: struct to pivot
+ * pivot_row: row of the pivot
+ * pivot_col: col of the pivot
+ */
+void defer_tableau_pivot(BlockedPivots_t* blocked, Tableau_t* tableau, int pivot_row, int pivot_col) {
+    STATS_START(eliminate_start);
+    int count = blocked->count;
+    int depth = blocked->depth;
+    int rhs = tableau->cols - 1;
+
+    // bring the pivot row up to date, then scale it like pivot_tableau_at
+    double* new_pivot_row = tableau_row(tableau, pivot_row);
+    double* factors = blocked->factors + (size_t) pivot_row * depth;
+    for (int pivot = 0; pivot < count; pivot++) {
+        if (factors[pivot] != 0) eliminate_row(new_pivot_row, blocked->pivot_rows + (size_t) pivot * blocked->stride, factors[pivot], tableau->stride);
+        factors[pivot] = 0;
+    }
+    double pivot_value = new_pivot_row[pivot_col];
+    for (int col = 0; col < tableau->cols; col++)
+        new_pivot_row[col] = new_pivot_row[col] / pivot_value;
+
+    double* objective_row = tableau_row(tableau, tableau->rows - 1);
+    double factor = objective_row[pivot_col];
+    if (factor != 0) eliminate_row(objective_row, new_pivot_row, factor, tableau->stride);
+
+    // the other rows get their right hand side and their zero in the pivot
+    // column now, and owe the rest of the pivot row
+    double* deferred_row = blocked->pivot_rows + (size_t) count * blocked->stride;
+    memcpy(deferred_row, new_pivot_row, tableau->stride * sizeof(double));
+    deferred_row[pivot_col] = 0;
+    deferred_row[rhs] = 0;
+    for (int row = 0; row < tableau->s_size; row++) {
+        double* cur_row = tableau_row(tableau, row);
+        factor = (row == pivot_row)? 0 : cur_row[pivot_col];
+        blocked->factors[(size_t) row * depth + count] = factor;
+        if (factor == 0) {
+            STATS_ADD(skipped_rows, row != pivot_row);
+            continue;
+        }
+
+        cur_row[rhs] = eliminate_entry(cur_row[rhs], factor, new_pivot_row[rhs]);
+        cur_row[pivot_col] = 0;
+    }
+
+    blocked->count = count + 1;
+    if (blocked->count == depth) flush_blocked_pivots(blocked, tableau);
+    STATS_CYCLES(eliminate_cycles, eliminate_start);
+}
+
+/**
+ * Pivots a tableau with deferred pivots, choosing the same pivot as
+ * pivot_tableau would on the up to date tableau. Only the pivot column is
+ * brought up to date for the ratio test.
+ *
+ * blocked: deferred pivots
+ * tableau: struct to pivot
+ * pricing: pivot rule state, NULL for dantzig's rule, not steepest edge,
+ *          which reads the whole tableau
+ * result: filled with the pivot used
+ */
+void pivot_blocked_tableau(BlockedPivots_t* blocked, Tableau_t* tableau, Pricing_t* pricing, PivotResult_t* result) {
+    STATS_START(select_start);
+
+    // find pivot column
+    int pivot_col = select_tableau_column(tableau, pricing);
+    result->pivot_col = pivot_col;
+    // bounds check for pivot column
+    if (pivot_col < 0) {
+        result->success = false;
+        return;
+    }
+
+    refresh_blocked_column(blocked, tableau, pivot_col);
+    int pivot_row = ratio_test(tableau, pivot_col, tie_basis(pricing));
+
+    result->pivot_row = pivot_row;
+    // bounds check for pivot row
+    if (pivot_row < 0) {
+        result->success = false;
+        return;
+    }
+
+    STATS_CYCLES(select_cycles, select_start);
+    defer_tableau_pivot(blocked, tableau, pivot_row, pivot_col);
+    if (pricing != NULL) update_tableau_pricing(pricing, tableau, pivot_row, pivot_col);
+    result->success = true;
+}
+
+/**
+ * Struct for the revised simplex method on the same linear program as the
+ * tableau. Instead of the full tableau it keeps the basis B factorized and
+ * prices columns of the payoff matrix on demand. The payoff matrix is kept
+ * sparse and the shift k is applied implicitly, so the shifted constraint
+ * matrix is never formed.
+ *
+ * Basic slack columns are unit vectors, so after ordering B is block lower
+ * triangular with an identity block. Only the kernel, the basic payoff
+ * columns restricted to the rows whose slack is not basic, is stored as a
+ * dense LU. Pivots since the last refactorization are kept as product form
+ * eta columns.
+ *
+ * matrix: payoff matrix in sparse form, not shifted by k
+ * m: number of rows
+ * n: number of columns
+ * k: shift added to every payoff entry
+ * pivot_tolerance: entering column entries at most this cannot pivot
+ * feasibility_tolerance: basic variables may go this far below zero
+ * basis: variable basic at each position, n + i for slack i
+ * is_basic: if each variable is basic, indexed like tableau columns
+ * x_basic: value of the basic variable at each position
+ * duals: simplex multipliers of the current basis, the slack part of the
+ *        tableau objective row
+ * dual_sum: sum of duals
+ * kernel_size: number of basic payoff columns at the last refactorization
+ * kernel_pos: position of each basic payoff column in kernel order
+ * kernel_vars: payoff column at each kernel position when factorized
+ * kernel_rows: row of each kernel row in kernel order
+ * slack_pos: position of slack i in the factorized basis, -1 if not basic
+ * lu: LU factors of the kernel, row-major, unit lower triangle implied
+ * lu_perm: row of the kernel used for each row of the LU
+ * lu_capacity: number of entries lu can hold
+ * eta_count: number of eta columns since the last refactorization
+ * eta_pos: position pivoted on by each eta column
+ * etas: eta columns, m entries each
+ * column: work vector for the entering column
+ * work: work vector of length m
+ * kernel_work: work vector of length m
+ * rho: pivot row of B^-1 for pricing weight updates
+ * edge: B^-T times the entering column for steepest edge updates
+ * ratios: pivot row over the pivot element for devex updates, n + m entries
+ */
+struct RevisedSimplex {
+    SparseMatrix_t* matrix;
+    int m;
+    int n;
+    double k;
+    double pivot_tolerance;
+    double feasibility_tolerance;
+    int* basis;
+    bool* is_basic;
+    double* x_basic;
+    double* duals;
+    double dual_sum;
+    int kernel_size;
+    int* kernel_pos;
+    int* kernel_vars;
+    int* kernel_rows;
+    int* slack_pos;
+    double* lu;
+    int* lu_perm;
+    size_t lu_capacity;
+    int eta_count;
+    int* eta_pos;
+    double* etas;
+    double* column;
+    double* work;
+    double* kernel_work;
+    double* rho;
+    double* edge;
+    double* ratios;
+};
+typedef struct RevisedSimplex RevisedSimplex_t;
+
+/**
+ * Writes a column of the shifted payoff matrix, which is the constraint
+ * matrix of the linear program, or of the slack identity
+ *
+ * revised: struct holding the payoff matrix
+ * var: column index like the tableau, n + i for slack i
+ * column: set to the dense column
+ */
+void revised_column(RevisedSimplex_t* revised, int var, double* column) {
+    SparseMatrix_t* matrix = revised->matrix;
+    if (var < revised->n) {
+        for (int row = 0; row < revised->m; row++) column[row] = revised->k;
+        for (size_t index = matrix->col_start[var]; index < matrix->col_start[var + 1]; index++)
+            column[matrix->row_index[index]] += matrix->values[index];
+    }
+    else {
+        for (int row = 0; row < revised->m; row++) column[row] = (double) (row == var - revised->n);
+    }
+}
+
+/**
+ * Solves B d = a for the current basis.
+ *
+ * revised: struct holding the factorization
+ * a: column indexed by row, left unchanged
+ * d: set to the solution indexed by basis position
+ */
+void ftran_revised(RevisedSimplex_t* revised, const double* a, double* d) {
+    int size = revised->kernel_size;
+    double* lu = revised->lu;
+    double* x = revised->kernel_work;
+
+    // kernel rows: L U x = P a
+    for (int r = 0; r < size; r++) {
+        double sum = a[revised->kernel_rows[revised->lu_perm[r]]];
+        for (int c = 0; c < r; c++) sum -= lu[r * size + c] * x[c];
+        x[r] = sum;
+    }
+    for (int r = size - 1; r >= 0; r--) {
+        double sum = x[r];
+        for (int c = r + 1; c < size; c++) sum -= lu[r * size + c] * x[c];
+        x[r] = sum / lu[r * size + r];
+    }
+
+    double kernel_sum = 0;
+    for (int c = 0; c < size; c++) {
+        d[revised->kernel_pos[c]] = x[c];
+        kernel_sum += x[c];
+    }
+
+    // slack rows take whatever the kernel columns leave over
+    for (int row = 0; row < revised->m; row++) {
+        int pos = revised->slack_pos[row];
+        if (pos >= 0) d[pos] = a[row] - revised->k * kernel_sum;
+    }
+
+    SparseMatrix_t* matrix = revised->matrix;
+    for (int c = 0; c < size; c++) {
+        if (x[c] == 0) continue;
+
+        int var = revised->kernel_vars[c];
+        for (size_t index = matrix->col_start[var]; index < matrix->col_start[var + 1]; index++) {
+            int pos = revised->slack_pos[matrix->row_index[index]];
+            if (pos >= 0) d[pos] -= matrix->values[index] * x[c];
+        }
+    }
+
+    // apply the eta columns in the order they were added
+    for (int eta = 0; eta < revised->eta_count; eta++) {
+        double* e = revised->etas + (size_t) eta * revised->m;
+        int pos = revised->eta_pos[eta];
+        double t = d[pos] / e[pos];
+        if (t != 0) {
+            for (int i = 0; i < revised->m; i++) d[i] -= e[i] * t;
+        }
+        d[pos] = t;
+    }
+}
+
+/**
+ * Solves B^T y = c for the current basis.
+ *
+ * revised: struct holding the factorization
+ * c: vector indexed by basis position, overwritten
+ * y: set to the solution indexed by row
+ */
+void btran_revised(RevisedSimplex_t* revised, double* c, double* y) {
+    int size = revised->kernel_size;
+    double* lu = revised->lu;
+    double* x = revised->kernel_work;
+
+    // apply the eta columns transposed, newest first
+    for (int eta = revised->eta_count - 1; eta >= 0; eta--) {
+        double* e = revised->etas + (size_t) eta * revised->m;
+        int pos = revised->eta_pos[eta];
+        double sum = c[pos];
+        for (int i = 0; i < revised->m; i++) {
+            if (i != pos) sum -= c[i] * e[i];
+        }
+        c[pos] = sum / e[pos];
+    }
+
+    // basic slacks fix their own row directly
+    double slack_sum = 0;
+    for (int row = 0; row < revised->m; row++) {
+        int pos = revised->slack_pos[row];
+        y[row] = (pos >= 0)? c[pos] : 0;
+        slack_sum += y[row];
+    }
+
+    // kernel: U^T L^T P y = c minus the slack rows' share, y is still zero
+    // on the kernel rows so whole columns can be summed
+    SparseMatrix_t* matrix = revised->matrix;
+    for (int r = 0; r < size; r++) {
+        int var = revised->kernel_vars[r];
+        double sum = c[revised->kernel_pos[r]] - revised->k * slack_sum;
+        for (size_t index = matrix->col_start[var]; index < matrix->col_start[var + 1]; index++)
+            sum -= matrix->values[index] * y[matrix->row_index[index]];
+        for (int i = 0; i < r; i++) sum -= lu[i * size + r] * x[i];
+        x[r] = sum / lu[r * size + r];
+    }
+    for (int r = size - 1; r >= 0; r--) {
+        double sum = x[r];
+        for (int i = r + 1; i < size; i++) sum -= lu[i * size + r] * x[i];
+        x[r] = sum;
+    }
+    for (int r = 0; r < size; r++)
+        y[revised->kernel_rows[revised->lu_perm[r]]] = x[r];
+}
+
+/**
+ * Factorizes the current basis from scratch, dropping all eta columns and
+ * recomputing the basic variable values.
+ *
+ * revised: struct to refactorize
+ *
+ * return: false if the basis is numerically singular
+ */
+bool refactor_revised(RevisedSimplex_t* revised) {
+    int m = revised->m;
+    int n = revised->n;
+
+    // split positions into basic slacks and the kernel columns
+    for (int row = 0; row < m; row++) revised->slack_pos[row] = -1;
+    int size = 0;
+    for (int pos = 0; pos < m; pos++) {
+        if (revised->basis[pos] >= n) {
+            revised->slack_pos[revised->basis[pos] - n] = pos;
+        }
+        else {
+            revised->kernel_vars[size] = revised->basis[pos];
+            revised->kernel_pos[size++] = pos;
+        }
+    }
+
+    int kernel_row = 0;
+    for (int row = 0; row < m; row++) {
+        if (revised->slack_pos[row] < 0) revised->kernel_rows[kernel_row++] = row;
+    }
+    revised->kernel_size = size;
+
+    // grow the LU storage only when the kernel outgrows it
+    size_t entries = (size_t) size * size;
+    if (entries > revised->lu_capacity) {
+        free(revised->lu);
+        revised->lu = (double*) malloc(entries * sizeof(double));
+        revised->lu_capacity = entries;
+    }
+
+    double* lu = revised->lu;
+    for (int c = 0; c < size; c++) {
+        revised_column(revised, revised->kernel_vars[c], revised->work);
+        for (int r = 0; r < size; r++)
+            lu[r * size + c] = revised->work[revised->kernel_rows[r]];
+    }
+    for (int r = 0; r < size; r++) revised->lu_perm[r] = r;
+
+    // gaussian elimination with partial pivoting
+    for (int c = 0; c < size; c++) {
+        int best = c;
+        for (int r = c + 1; r < size; r++) {
+            if (fabs(lu[r * size + c]) > fabs(lu[best * size + c])) best = r;
+        }
+        if (lu[best * size + c] == 0) return false;
+
+        if (best != c) {
+            for (int col = 0; col < size; col++) {
+                double swap = lu[c * size + col];
+                lu[c * size + col] = lu[best * size + col];
+                lu[best * size + col] = swap;
+            }
+            int swap = revised->lu_perm[c];
+            revised->lu_perm[c] = revised->lu_perm[best];
+            revised->lu_perm[best] = swap;
+        }
+
+        for (int r = c + 1; r < size; r++) {
+            double factor = lu[r * size + c] / lu[c * size + c];
+            lu[r * size + c] = factor;
+            if (factor == 0) continue;
+            for (int col = c + 1; col < size; col++)
+                lu[r * size + col] -= factor * lu[c * size + col];
+        }
+    }
+
+    revised->eta_count = 0;
+
+    // the right hand side is all ones, so x_basic = B^-1 1
+    for (int row = 0; row < m; row++) revised->column[row] = 1;
+    ftran_revised(revised, revised->column, revised->x_basic);
+    return true;
+}
+
+
+/**
+ * Builds the revised simplex struct at the all slack basis, the same
+ * starting point as load_init_tableau.
+ *
+ * matrix: payoff matrix in sparse form, must outlive the struct
+ *
+ * return: initial revised simplex struct
+ */
+RevisedSimplex_t* create_revised(SparseMatrix_t* matrix) {
+    int m = matrix->m;
+    int n = matrix->n;
+
+    RevisedSimplex_t* revised = (RevisedSimplex_t*) malloc(sizeof(RevisedSimplex_t));
+    revised->matrix = matrix;
+    revised->m = m;
+    revised->n = n;
+    revised->k = sparse_shift(matrix);
+    revised->pivot_tolerance = PIVOT_TOLERANCE;
+    revised->feasibility_tolerance = FEASIBILITY_TOLERANCE;
+
+    revised->basis = (int*) calloc(m, sizeof(int));
+    revised->is_basic = (bool*) calloc(n + m, sizeof(bool));
+    for (int pos = 0; pos < m; pos++) {
+        revised->basis[pos] = n + pos;
+        revised->is_basic[n + pos] = true;
+    }
+
+    revised->x_basic = (double*) calloc(m, sizeof(double));
+    revised->duals = (double*) calloc(m, sizeof(double));
+    revised->kernel_pos = (int*) calloc(m, sizeof(int));
+    revised->kernel_vars = (int*) calloc(m, sizeof(int));
+    revised->kernel_rows = (int*) calloc(m, sizeof(int));
+    revised->slack_pos = (int*) calloc(m, sizeof(int));
+    revised->lu = NULL;
+    revised->lu_perm = (int*) calloc(m, sizeof(int));
+    revised->lu_capacity = 0;
+    revised->eta_pos = (int*) calloc(REFACTOR_INTERVAL, sizeof(int));
+    revised->etas = (double*) calloc((size_t) REFACTOR_INTERVAL * m, sizeof(double));
+    revised->column = (double*) calloc(m, sizeof(double));
+    revised->work = (double*) calloc(m, sizeof(double));
+    revised->kernel_work = (double*) calloc(m, sizeof(double));
+    revised->rho = (double*) calloc(m, sizeof(double));
+    revised->edge = (double*) calloc(m, sizeof(double));
+    revised->ratios = (double*) calloc(n + m, sizeof(double));
+    revised->dual_sum = 0;
+
+    refactor_revised(revised);
+    return revised;
+}
+
+/**
+ * Frees a revised simplex struct, but not the matrix it refers to
+ *
+ * revised: struct to free
+ */
+void free_revised(RevisedSimplex_t* revised) {
+    free(revised->basis);
+    free(revised->is_basic);
+    free(revised->x_basic);
+    free(revised->duals);
+    free(revised->kernel_pos);
+    free(revised->kernel_vars);
+    free(revised->kernel_rows);
+    free(revised->slack_pos);
+    free(revised->lu);
+    free(revised->lu_perm);
+    free(revised->eta_pos);
+    free(revised->etas);
+    free(revised->column);
+    free(revised->work);
+    free(revised->kernel_work);
+    free(revised->rho);
+    free(revised->edge);
+    free(revised->ratios);
+    free(revised);
+}
+
+/**
+ * Gets the objective value of the current basis, the bottom right entry of
+ * the equivalent tableau
+ *
+ * revised: struct to read
+ *
+ * return: sum of the basic payoff column variables
+ */
+double revised_objective(RevisedSimplex_t* revised) {
+    double v = 0;
+    for (int pos = 0; pos < revised->m; pos++) {
+        if (revised->basis[pos] < revised->n) v += revised->x_basic[pos];
+    }
+    return v;
+}
+
+/**
+ * Multiplies a row vector with a column of the constraint matrix or the
+ * slack identity
+ *
+ * revised: struct holding the payoff matrix
+ * var: column index like the tableau, n + i for slack i
+ * y: row vector indexed by row
+ * y_sum: sum of y, which carries the implicit shift
+ *
+ * return: y^T times the column
+ */
+double revised_dot(RevisedSimplex_t* revised, int var, const double* y, double y_sum) {
+    if (var >= revised->n) return y[var - revised->n];
+
+    SparseMatrix_t* matrix = revised->matrix;
+    double value = revised->k * y_sum;
+    for (size_t index = matrix->col_start[var]; index < matrix->col_start[var + 1]; index++)
+        value += y[matrix->row_index[index]] * matrix->values[index];
+    return value;
+}
+
+/**
+ * Gets a reduced cost from the current duals of a revised simplex struct
+ *
+ * context: revised simplex struct being priced
+ * col: column index, n + i for slack i
+ *
+ * return: entry of the equivalent tableau objective row
+ */
+double revised_price(void* context, int col) {
+    RevisedSimplex_t* revised = (RevisedSimplex_t*) context;
+    if (revised->is_basic[col]) return 0;
+
+    double value = revised_dot(revised, col, revised->duals, revised->dual_sum);
+    return (col < revised->n)? value - 1 : value;
+}
+
+/**
+ * Sets the initial steepest edge weights for the all slack basis, where the
+ * edge of a payoff column is the shifted column itself
+ *
+ * pricing: pricing state to initialize
+ * revised: struct at the all slack basis
+ */
+void init_revised_pricing(Pricing_t* pricing, RevisedSimplex_t* revised) {
+    if (pricing->rule != RULE_STEEPEST_EDGE) return;
+
+    SparseMatrix_t* matrix = revised->matrix;
+    double k = revised->k;
+    for (int col = 0; col < revised->n; col++) {
+        size_t start = matrix->col_start[col];
+        size_t end = matrix->col_start[col + 1];
+
+        // the implicit zeros contribute k^2 each
+        double weight = 1 + (revised->m - (double) (end - start)) * k * k;
+        for (size_t index = start; index < end; index++)
+            weight += (matrix->values[index] + k) * (matrix->values[index] + k);
+        pricing->weights[col] = weight;
+    }
+}
+
+/**
+ * Updates steepest edge or devex weights for a pivot, before the basis
+ * changes.
+ *
+ * pricing: pricing state to update
+ * revised: struct about to pivot
+ * pivot_row: leaving position
+ * pivot_col: entering column
+ * d: entering column in terms of the current basis
+ */
+void update_revised_pricing(Pricing_t* pricing, RevisedSimplex_t* revised, int pivot_row, int pivot_col, const double* d) {
+    int m = revised->m;
+    int n = revised->n;
+    double pivot_value = d[pivot_row];
+    int leaving = revised->basis[pivot_row];
+
+    // pivot row of the tableau is rho^T A with rho the pivot row of B^-1
+    for (int pos = 0; pos < m; pos++) revised->work[pos] = (double) (pos == pivot_row);
+    btran_revised(revised, revised->work, revised->rho);
+    double rho_sum = 0;
+    for (int row = 0; row < m; row++) rho_sum += revised->rho[row];
+
+    if (pricing->rule == RULE_DEVEX) {
+        for (int col = 0; col < n + m; col++) {
+            if (col == leaving) revised->ratios[col] = 1 / pivot_value;
+            else if (revised->is_basic[col]) revised->ratios[col] = 0;
+            else revised->ratios[col] = revised_dot(revised, col, revised->rho, rho_sum) / pivot_value;
+        }
+        update_devex_weights(pricing, pivot_col, revised->ratios);
+        return;
+    }
+
+    // goldfarb and reid update, with the entering weight refreshed exactly
+    double entering = 1;
+    for (int pos = 0; pos < m; pos++) {
+        entering += d[pos] * d[pos];
+        revised->column[pos] = d[pos];
+    }
+    btran_revised(revised, revised->column, revised->edge);
+    double edge_sum = 0;
+    for (int row = 0; row < m; row++) edge_sum += revised->edge[row];
+
+    for (int col = 0; col < n + m; col++) {
+        if (col == pivot_col || revised->is_basic[col]) continue;
+
+        double ratio = revised_dot(revised, col, revised->rho, rho_sum) / pivot_value;
+        if (ratio == 0) continue;
+
+        double weight = pricing->weights[col] - 2 * ratio * revised_dot(revised, col, revised->edge, edge_sum) + ratio * ratio * entering;
+        pricing->weights[col] = fmax(weight, 1 + ratio * ratio);
+    }
+    pricing->weights[leaving] = fmax(entering / (pivot_value * pivot_value), 1);
+    pricing->weights[pivot_col] = 1;
+}
+
+/**
+ * Computes the duals of the current basis of a revised simplex struct from
+ * the objective coefficients of its basic variables
+ *
+ * revised: struct to update
+ */
+void update_revised_duals(RevisedSimplex_t* revised) {
+    int m = revised->m;
+    int n = revised->n;
+    for (int pos = 0; pos < m; pos++) revised->work[pos] = (revised->basis[pos] < n)? 1 : 0;
+    btran_revised(revised, revised->work, revised->duals);
+
+    // basic slack columns price to exactly zero, drop any rounding left over
+    for (int row = 0; row < m; row++) {
+        if (revised->is_basic[n + row]) revised->duals[row] = 0;
+    }
+
+    revised->dual_sum = 0;
+    for (int row = 0; row < m; row++) revised->dual_sum += revised->duals[row];
+}
+
+/**
+ * Pivots a revised simplex struct on a position and entering column. The
+ * entering variable moves by the ratio of the leaving basic variable to its
+ * pivot entry, so the basic variables stay B^-1 b.
+ *
+ * revised: struct to pivot
+ * pivot_row: leaving position
+ * pivot_col: entering column
+ * d: entering column in terms of the current basis, the next eta column
+ *
+ * return: false if refactorizing found the basis numerically singular
+ */
+bool pivot_revised_at(RevisedSimplex_t* revised, int pivot_row, int pivot_col, const double* d) {
+    // update basic variable values
+    double theta = revised->x_basic[pivot_row] / d[pivot_row];
+    for (int pos = 0; pos < revised->m; pos++) revised->x_basic[pos] -= theta * d[pos];
+    revised->x_basic[pivot_row] = theta;
+
+    // update basis, keeping d as the eta column of this pivot
+    revised->is_basic[revised->basis[pivot_row]] = false;
+    revised->is_basic[pivot_col] = true;
+    revised->basis[pivot_row] = pivot_col;
+    revised->eta_pos[revised->eta_count++] = pivot_row;
+
+    return (revised->eta_count < REFACTOR_INTERVAL)? true : refactor_revised(revised);
+}
+
+/**
+ * Performs one revised simplex iteration, choosing the same pivot as
+ * pivot_tableau would on the equivalent tableau.
+ *
+ * revised: struct to pivot
+ * pricing: pivot rule state, NULL for dantzig's rule
+ * result: filled with the pivot used, rows are basis positions
+ */
+void pivot_revised(RevisedSimplex_t* revised, Pricing_t* pricing, PivotResult_t* result) {
+    STATS_START(select_start);
+    int m = revised->m;
+    int n = revised->n;
+
+    // duals from the objective coefficients of the basic variables
+    update_revised_duals(revised);
+
+    // price every nonbasic column, payoff columns first like the tableau
+    double min_value = -PRICE_TOLERANCE; // trying to find most negative number
+    int pivot_col = -1;
+
+    if (pricing != NULL && pricing->rule != RULE_DANTZIG) {
+        pivot_col = select_column(pricing, revised_price, revised, PRICE_TOLERANCE);
+    }
+    else {
+        for (int col = 0; col < n + m; col++) {
+            double value = revised_price(revised, col);
+            if (value < min_value) {
+                min_value = value;
+                pivot_col = col;
+            }
+        }
+    }
+
+    result->pivot_col = pivot_col;
+    // bounds check for pivot column
+    if (pivot_col < 0) {
+        result->success = false;
+        return;
+    }
+
+    // entering column in terms of the current basis
+    revised_column(revised, pivot_col, revised->column);
+
+    double* d = revised->etas + (size_t) revised->eta_count * m;
+    ftran_revised(revised, revised->column, d);
+
+    // find pivot row with Harris' two pass ratio test, like ratio_test.
+    // degenerate rows with a zero ratio are allowed to leave
+    RatioBounds_t bounds = { DBL_MAX, DBL_MAX, 0 };
+    for (int pos = 0; pos < m; pos++) {
+        if (d[pos] <= revised->pivot_tolerance) continue;
+
+        add_ratio_bound(&bounds, fmax(revised->x_basic[pos], 0), d[pos], revised->feasibility_tolerance);
+    }
+
+    // largest entry within the bound, or under bland's rule the tie with
+    // the lowest basic variable
+    bool bland = pricing != NULL && pricing->rule == RULE_BLAND;
+    double best = DBL_MAX;
+    int pivot_row = -1;
+
+    for (int pos = 0; pos < m; pos++) {
+        double rhs = fmax(revised->x_basic[pos], 0);
+        if (d[pos] <= revised->pivot_tolerance || rhs / d[pos] > bounds.bound) continue;
+
+        double value = harris_score(&bounds, rhs, d[pos], revised->feasibility_tolerance, (bland)? revised->basis[pos] : -1);
+        if (value < best) {
+            best = value;
+            pivot_row = pos;
+        }
+    }
+
+    result->pivot_row = pivot_row;
+    // bounds check for pivot row
+    if (pivot_row < 0) {
+        result->success = false;
+        return;
+    }
+    STATS_CYCLES(select_cycles, select_start);
+    STATS_START(eliminate_start);
+
+    if (pricing != NULL && (pricing->rule == RULE_STEEPEST_EDGE || pricing->rule == RULE_DEVEX))
+        update_revised_pricing(pricing, revised, pivot_row, pivot_col, d);
+
+    result->success = pivot_revised_at(revised, pivot_row, pivot_col, d);
+    STATS_CYCLES(eliminate_cycles, eliminate_start);
+}
+
+/**
+ * Takes a dual simplex pivot on a revised simplex struct whose reduced costs
+ * are nonnegative, choosing the pivot select_dual_pivot would on the
+ * equivalent tableau. The leaving row of that tableau is rho^T A, with rho
+ * the leaving row of B^-1.
+ *
+ * revised: struct to pivot
+ * result: filled like select_dual_pivot, rows are basis positions
+ */
+void dual_pivot_revised(RevisedSimplex_t* revised, PivotResult_t* result) {
+    int m = revised->m;
+    int n = revised->n;
+
+    // find pivot row
+    double min_value = -revised->feasibility_tolerance; // trying to find most negative number
+    int pivot_row = -1;
+    for (int pos = 0; pos < m; pos++) {
+        if (revised->x_basic[pos] < min_value) {
+            min_value = revised->x_basic[pos];
+            pivot_row = pos;
+        }
+    }
+
+    result->pivot_row = pivot_row;
+    result->pivot_col = -1;
+    result->success = false;
+    if (pivot_row < 0) return;
+
+    // find pivot column, the smallest ratio of reduced cost to the magnitude
+    // of a negative pivot row entry
+    update_revised_duals(revised);
+    for (int pos = 0; pos < m; pos++) revised->work[pos] = (double) (pos == pivot_row);
+    btran_revised(revised, revised->work, revised->rho);
+    double rho_sum = 0;
+    for (int row = 0; row < m; row++) rho_sum += revised->rho[row];
+
+    min_value = DBL_MAX; // finding smallest value
+    int pivot_col = -1;
+    for (int col = 0; col < n + m; col++) {
+        if (revised->is_basic[col]) continue;
+
+        double entry = revised_dot(revised, col, revised->rho, rho_sum);
+        if (entry >= -revised->pivot_tolerance) continue;
+
+        double value = fmax(revised_price(revised, col), 0) / -entry;
+        if (value < min_value) {
+            min_value = value;
+            pivot_col = col;
+        }
+    }
+
+    result->pivot_col = pivot_col;
+    if (pivot_col < 0) return;
+
+    revised_column(revised, pivot_col, revised->column);
+    double* d = revised->etas + (size_t) revised->eta_count * m;
+    ftran_revised(revised, revised->column, d);
+    result->success = d[pivot_row] < 0 && pivot_revised_at(revised, pivot_row, pivot_col, d);
+}
+
+
+/**
+ * Struct for the game presolve leaves after removing dominated strategies
+ *
+ * rows: payoff row of each kept row
+ * cols: payoff column of each kept column
+ * row_index: kept row of each payoff row, -1 for a removed row
+ * col_index: kept column of each payoff column, -1 for a removed column
+ * m: number of kept rows
+ * n: number of kept columns
+ * payoff: m by n payoff matrix of the kept game, row-major
+ * p1_strategy: strategy of the row player in the kept game
+ * p2_strategy: strategy of the column player in the kept game
+ * start_rows: rows of the start basis in the kept game
+ * start_cols: columns of the start basis in the kept game
+ * row_capacity: number of payoff rows the row buffers hold
+ * col_capacity: number of payoff columns the column buffers hold
+ * payoff_capacity: number of entries payoff holds
+ */
+struct Presolve {
+    int* rows;
+    int* cols;
+    int* row_index;
+    int* col_index;
+    int m;
+    int n;
+    double* payoff;
+    double* p1_strategy;
+    double* p2_strategy;
+    int* start_rows;
+    int* start_cols;
+    int row_capacity;
+    int col_capacity;
+    size_t payoff_capacity;
+};
+typedef struct Presolve Presolve_t;
+
+/**
+ * Frees a presolve struct and its buffers
+ *
+ * presolve: struct to free
+ */
+void free_presolve(Presolve_t* presolve) {
+    free(presolve->rows);
+    free(presolve->cols);
+    free(presolve->row_index);
+    free(presolve->col_index);
+    free(presolve->payoff);
+    free(presolve->p1_strategy);
+    free(presolve->p2_strategy);
+    free(presolve->start_rows);
+    free(presolve->start_cols);
+    free(presolve);
+}
+
+/**
+ * Grows the buffers of a presolve struct to a game and keeps every row and
+ * column of it
+ *
+ * presolve: struct to reset
+ * m: number of rows of the game
+ * n: number of columns of the game
+ */
+void reset_presolve(Presolve_t* presolve, int m, int n) {
+    if (m > presolve->row_capacity) {
+        presolve->rows = (int*) realloc(presolve->rows, m * sizeof(int));
+        presolve->row_index = (int*) realloc(presolve->row_index, m * sizeof(int));
+        presolve->p1_strategy = (double*) realloc(presolve->p1_strategy, m * sizeof(double));
+        presolve->start_rows = (int*) realloc(presolve->start_rows, m * sizeof(int));
+        presolve->start_cols = (int*) realloc(presolve->start_cols, m * sizeof(int));
+        presolve->row_capacity = m;
+    }
+    if (n > presolve->col_capacity) {
+        presolve->cols = (int*) realloc(presolve->cols, n * sizeof(int));
+        presolve->col_index = (int*) realloc(presolve->col_index, n * sizeof(int));
+        presolve->p2_strategy = (double*) realloc(presolve->p2_strategy, n * sizeof(double));
+        presolve->col_capacity = n;
+    }
+
+    for (int row = 0; row < m; row++) presolve->rows[row] = row;
+    for (int col = 0; col < n; col++) presolve->cols[col] = col;
+    presolve->m = m;
+    presolve->n = n;
+}
+
+/**
+ * Removes the rows some other kept row is at least as good as against every
+ * kept column, which the row player never needs. Of equal rows the first is
+ * kept. Comparing a pair stops at the first column that orders it neither
+ * way, so on most games each pair costs a few entries.
+ *
+ * presolve: struct holding the kept rows and columns
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * n: number of payoff columns
+ *
+ * return: if a row was removed
+ */
+bool remove_dominated_rows(Presolve_t* presolve, const void* payoff, Dtype_t dtype, int n) {
+    int* rows = presolve->rows;
+    const int* cols = presolve->cols;
+    int kept = presolve->m;
+
+    for (int index = 0; index < presolve->m; index++) {
+        bool dominated = false;
+        for (int other = 0; other < presolve->m && !dominated; other++) {
+            if (other == index || rows[other] < 0) continue;
+
+            size_t row = (size_t) rows[index] * n;
+            size_t by = (size_t) rows[other] * n;
+            bool at_most = true;
+            bool at_least = true;
+            for (int col = 0; col < presolve->n && at_most; col++) {
+                double value = payoff_entry(payoff, dtype, row + cols[col]);
+                double by_value = payoff_entry(payoff, dtype, by + cols[col]);
+                at_most = value <= by_value;
+                at_least = at_least && value >= by_value;
+            }
+            dominated = at_most && (!at_least || other < index);
+        }
+        if (dominated) {
+            rows[index] = -1;
+            kept--;
+        }
+    }
+
+    if (kept == presolve->m) return false;
+    kept = 0;
+    for (int index = 0; index < presolve->m; index++) {
+        if (rows[index] >= 0) rows[kept++] = rows[index];
+    }
+    presolve->m = kept;
+    return true;
+}
+
+/**
+ * Removes the columns some other kept column is at most as large as against
+ * every kept row, which the column player never needs. Of equal columns the
+ * first is kept.
+ *
+ * presolve: struct holding the kept rows and columns
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * n: number of payoff columns
+ *
+ * return: if a column was removed
+ */
+bool remove_dominated_cols(Presolve_t* presolve, const void* payoff, Dtype_t dtype, int n) {
+    const int* rows = presolve->rows;
+    int* cols = presolve->cols;
+    int kept = presolve->n;
+
+    for (int index = 0; index < presolve->n; index++) {
+        bool dominated = false;
+        for (int other = 0; other < presolve->n && !dominated; other++) {
+            if (other == index || cols[other] < 0) continue;
+
+            bool at_least = true;
+            bool at_most = true;
+            for (int row = 0; row < presolve->m && at_least; row++) {
+                size_t start = (size_t) rows[row] * n;
+                double value = payoff_entry(payoff, dtype, start + cols[index]);
+                double by_value = payoff_entry(payoff, dtype, start + cols[other]);
+                at_least = value >= by_value;
+                at_most = at_most && value <= by_value;
+            }
+            dominated = at_least && (!at_most || other < index);
+        }
+        if (dominated) {
+            cols[index] = -1;
+            kept--;
+        }
+    }
+
+    if (kept == presolve->n) return false;
+    kept = 0;
+    for (int index = 0; index < presolve->n; index++) {
+        if (cols[index] >= 0) cols[kept++] = cols[index];
+    }
+    presolve->n = kept;
+    return true;
+}
+
+/**
+ * Presolves a game, removing dominated rows and columns until none is left.
+ * Weak dominance keeps the value, and the optimal strategies of the kept
+ * game are optimal in the whole game with the removed strategies played
+ * with probability 0.
+ *
+ * presolve: struct to fill
+ * payoff: m by n payoff matrix, row-major
+ * dtype: type of the entries of payoff
+ * m: number of rows
+ * n: number of columns
+ */
+void presolve_game(Presolve_t* presolve, const void* payoff, Dtype_t dtype, int m, int n) {
+    reset_presolve(presolve, m, n);
+    bool removed = true;
+    while (removed) {
+        removed = remove_dominated_rows(presolve, payoff, dtype, n);
+        removed = remove_dominated_cols(presolve, payoff, dtype, n) || removed;
+    }
+
+    for (int row = 0; row < m; row++) presolve->row_index[row] = -1;
+    for (int col = 0; col < n; col++) presolve->col_index[col] = -1;
+    for (int row = 0; row < presolve->m; row++) presolve->row_index[presolve->rows[row]] = row;
+    for (int col = 0; col < presolve->n; col++) presolve->col_index[presolve->cols[col]] = col;
+}
+
+/**
+ * Copies the kept game out of a payoff matrix
+ *
+ * presolve: struct holding the kept rows and columns
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * n: number of payoff columns
+ */
+void copy_kept_game(Presolve_t* presolve, const void* payoff, Dtype_t dtype, int n) {
+    size_t size = (size_t) presolve->m * presolve->n;
+    if (size > presolve->payoff_capacity) {
+        free(presolve->payoff);
+        presolve->payoff = (double*) malloc(size * sizeof(double));
+        presolve->payoff_capacity = size;
+    }
+
+    for (int row = 0; row < presolve->m; row++) {
+        double* kept_row = presolve->payoff + (size_t) row * presolve->n;
+        size_t start = (size_t) presolve->rows[row] * n;
+        for (int col = 0; col < presolve->n; col++) kept_row[col] = payoff_entry(payoff, dtype, start + presolve->cols[col]);
+    }
+}
+
+/**
+ * Finds a saddle point of the kept game, an entry that is the smallest of
+ * its row and the largest of its column, so both players playing it purely
+ * is optimal. It is a saddle point of the whole game too, since every
+ * removed strategy is dominated by a kept one.
+ *
+ * presolve: struct holding the kept game, whose strategies are overwritten
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * n: number of payoff columns
+ * saddle_row: set to the kept row of the saddle point
+ * saddle_col: set to the kept column of the saddle point
+ *
+ * return: if the kept game has a saddle point
+ */
+bool find_saddle_point(Presolve_t* presolve, const void* payoff, Dtype_t dtype, int n, int* saddle_row, int* saddle_col) {
+    const int* rows = presolve->rows;
+    const int* cols = presolve->cols;
+    double* row_min = presolve->p1_strategy;
+    double* col_max = presolve->p2_strategy;
+
+    for (int col = 0; col < presolve->n; col++) col_max[col] = -DBL_MAX;
+    for (int row = 0; row < presolve->m; row++) {
+        size_t start = (size_t) rows[row] * n;
+        row_min[row] = DBL_MAX;
+        for (int col = 0; col < presolve->n; col++) {
+            double value = payoff_entry(payoff, dtype, start + cols[col]);
+            row_min[row] = fmin(row_min[row], value);
+            col_max[col] = fmax(col_max[col], value);
+        }
+    }
+
+    for (int row = 0; row < presolve->m; row++) {
+        size_t start = (size_t) rows[row] * n;
+        for (int col = 0; col < presolve->n; col++) {
+            double value = payoff_entry(payoff, dtype, start + cols[col]);
+            if (value == row_min[row] && value == col_max[col]) {
+                *saddle_row = row;
+                *saddle_col = col;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Maps a basis of a game to its kept game, dropping it when one of its
+ * pivots uses a removed row or column
+ *
+ * presolve: struct holding the kept game
+ * basis: basis of the whole game
+ * m: number of payoff rows
+ * n: number of payoff columns
+ * kept: filled with the basis of the kept game, in the start buffers
+ *
+ * return: if every pivot of the basis was kept
+ */
+bool presolve_basis(Presolve_t* presolve, const SolveBasis_t* basis, int m, int n, SolveBasis_t* kept) {
+    kept->count = 0;
+    kept->rows = presolve->start_rows;
+    kept->cols = presolve->start_cols;
+    for (int pivot = 0; pivot < basis->count; pivot++) {
+        int row = basis->rows[pivot];
+        int col = basis->cols[pivot];
+        if (row < 0 || row >= m || col < 0 || col >= n + m || kept->count == presolve->m) return false;
+
+        int kept_row = presolve->row_index[row];
+        int kept_col = (col < n)? presolve->col_index[col] : presolve->row_index[col - n];
+        if (kept_row < 0 || kept_col < 0) return false;
+        kept->rows[kept->count] = kept_row;
+        kept->cols[kept->count] = (col < n)? kept_col : presolve->n + kept_col;
+        kept->count++;
+    }
+    return true;
+}
+
+/**
+ * Maps a basis of the kept game back to the whole game, in place
+ *
+ * presolve: struct holding the kept game
+ * basis: basis to map
+ * n: number of payoff columns
+ */
+void unpresolve_basis(Presolve_t* presolve, SolveBasis_t* basis, int n) {
+    for (int pivot = 0; pivot < basis->count; pivot++) {
+        int col = basis->cols[pivot];
+        basis->rows[pivot] = presolve->rows[basis->rows[pivot]];
+        basis->cols[pivot] = (col < presolve->n)? presolve->cols[col] : n + presolve->rows[col - presolve->n];
+    }
+}
+
+/**
+ * Struct for a slot of the set of bases visited during a stall
+ *
+ * hash: hash of the basis
+ * generation: stall the slot was filled in, slots of earlier stalls are empty
+ */
+struct StallEntry {
+    uint64_t hash;
+    unsigned generation;
+};
+typedef struct StallEntry StallEntry_t;
+
+/**
+ * Struct for the buffers one thread reuses across the games it solves, each
+ * grown to the largest game seen so far
+ *
+ * tableau: tableau of the last game, NULL before the first or when the
+ *          revised engine is used
+ * float_tableau: single precision tableau, NULL before the first game
+ *                solved in single or mixed precision
+ * exact_tableau: exact tableau, NULL before the first game solved exactly
+ * pool: pivot pool for the tableau engine, NULL to pivot serially
+ * blocked: deferred pivots of the double precision tableau, NULL before the
+ *          first game solved with blocked pivots
+ * pricing: pivot rule state, NULL for dantzig's rule or before the first game
+ * bland: state for bland's rule while the objective stalls, NULL before the
+ *        first stall
+ * stall_bases: open addressed set of the hashes of the bases visited since
+ *              the objective last grew
+ * stall_capacity: number of slots allocated for stall_bases, a power of two
+ * stall_generation: number of the current stall, which the slots it filled
+ *                   are tagged with
+ * presolve: kept game of the last presolved game, NULL before the first
+ * basis: column basic in each row, updated on every pivot
+ * sequence: rows that have pivoted, in the order they last pivoted
+ * sequence_count: number of rows in sequence
+ * refine_rows: rows of the pivots a mixed precision solve refines
+ * refine_cols: columns of the pivots a mixed precision solve refines
+ * row_capacity: number of entries allocated for basis, sequence and the
+ *               refined pivots
+ * solved: tableau holds the final tableau of the last game, which can have
+ *         rows and columns appended
+ * m: number of rows of the last game
+ * n: number of columns of the last game
+ * pivot_budget: pivots the current solve may still take
+ * deadline: monotonic time the current solve stops at, 0 for none
+ * timings: filled with the time the current solve spends in each phase,
+ *          untimed if it is not timed
+ * untimed: phases of a solve that is not timed, which only its pointer is
+ *          taken of
+ * timed: the current solve is timed
+ * status: SOLVE_OPTIMAL, or the limit the current solve stopped at
+ */
+struct Workspace {
+    Tableau_t* tableau;
+    FloatTableau_t* float_tableau;
+    ExactTableau_t* exact_tableau;
+    PivotPool_t* pool;
+    BlockedPivots_t* blocked;
+    Pricing_t* pricing;
+    Pricing_t* bland;
+    StallEntry_t* stall_bases;
+    int stall_capacity;
+    unsigned stall_generation;
+    Presolve_t* presolve;
+    int* basis;
+    int* sequence;
+    int sequence_count;
+    int* refine_rows;
+    int* refine_cols;
+    int row_capacity;
+    bool solved;
+    int m;
+    int n;
+    int pivot_budget;
+    double deadline;
+    SolveTimings_t* timings;
+    SolveTimings_t untimed;
+    bool timed;
+    SolveStatus_t status;
+};
+
+void default_solve_options(SolveOptions_t* options) {
+    options->engine = ENGINE_TABLEAU;
+    options->rule = RULE_DANTZIG;
+    options->precision = PRECISION_DOUBLE;
+    options->threads = 1;
+    options->block_pivots = 0;
+    options->tableau_dir = NULL;
+    options->trace_every = 0;
+    options->trace = NULL;
+    options->start = NULL;
+    options->pivot_tolerance = 0;
+    options->feasibility_tolerance = 0;
+    options->max_pivots = 0;
+    options->time_limit = 0;
+    options->presolve = false;
+    options->cache = NULL;
+    options->timings = NULL;
+    options->stats = NULL;
+}
+
+bool solve_stats_enabled() {
+#ifdef SIMPLEX_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+unsigned long long read_stats_cycles() {
+#ifdef SIMPLEX_STATS
+    return read_cycles();
+#else
+    return 0;
+#endif
+}
+
+Workspace_t* create_workspace() {
+    pthread_once(&kernels_resolved, resolve_kernels);
+    return (Workspace_t*) calloc(1, sizeof(Workspace_t));
+}
+
+void free_workspace(Workspace_t* workspace) {
+    if (workspace->tableau != NULL) free_tableau(workspace->tableau);
+    if (workspace->float_tableau != NULL) free_float_tableau(workspace->float_tableau);
+    if (workspace->exact_tableau != NULL) free_exact_tableau(workspace->exact_tableau);
+    if (workspace->pool != NULL) free_pivot_pool(workspace->pool);
+    if (workspace->blocked != NULL) free_blocked_pivots(workspace->blocked);
+    if (workspace->pricing != NULL) free_pricing(workspace->pricing);
+    if (workspace->bland != NULL) free_pricing(workspace->bland);
+    if (workspace->presolve != NULL) free_presolve(workspace->presolve);
+    free(workspace->stall_bases);
+    free(workspace->basis);
+    free(workspace->sequence);
+    free(workspace->refine_rows);
+    free(workspace->refine_cols);
+    free(workspace);
+}
+
+/**
+ * Grows the buffers tracking the basis, keeping what they hold
+ *
+ * workspace: buffers to grow
+ * m: number of rows they must cover
+ */
+void reserve_basis_tracking(Workspace_t* workspace, int m) {
+    if (m > workspace->row_capacity) {
+        workspace->basis = (int*) realloc(workspace->basis, m * sizeof(int));
+        workspace->sequence = (int*) realloc(workspace->sequence, m * sizeof(int));
+        workspace->refine_rows = (int*) realloc(workspace->refine_rows, m * sizeof(int));
+        workspace->refine_cols = (int*) realloc(workspace->refine_cols, m * sizeof(int));
+        workspace->row_capacity = m;
+    }
+}
+
+/**
+ * Starts tracking the basis of a new game at the all slack basis
+ *
+ * workspace: buffers to track the basis in, grown if needed
+ * m: number of rows
+ * n: number of columns
+ */
+void reset_basis_tracking(Workspace_t* workspace, int m, int n) {
+    reserve_basis_tracking(workspace, m);
+
+    for (int row = 0; row < m; row++) workspace->basis[row] = n + row;
+    workspace->sequence_count = 0;
+}
+
+/**
+ * Records a pivot in the basis tracked by a workspace
+ *
+ * workspace: buffers tracking the basis
+ * pivot_row: row of the pivot
+ * pivot_col: column entering the basis
+ */
+void record_pivot(Workspace_t* workspace, int pivot_row, int pivot_col) {
+    STATS_ADD(pivots, 1);
+    workspace->basis[pivot_row] = pivot_col;
+
+    // move the row to the end of the sequence
+    int* sequence = workspace->sequence;
+    int index = 0;
+    while (index < workspace->sequence_count && sequence[index] != pivot_row) index++;
+    if (index < workspace->sequence_count)
+        memmove(sequence + index, sequence + index + 1, (workspace->sequence_count - index - 1) * sizeof(int));
+    else workspace->sequence_count++;
+    sequence[workspace->sequence_count - 1] = pivot_row;
+}
+
+/**
+ * Checks if a start basis pivot can be taken from the tracked basis: it is
+ * in range and enters a column that is not basic yet. A pivot already taken
+ * is not valid again.
+ *
+ * workspace: buffers tracking the basis
+ * m: number of rows
+ * n: number of columns
+ * pivot_row: row of the pivot
+ * pivot_col: column entering the basis
+ *
+ * return: if the pivot can be taken
+ */
+bool valid_start_pivot(Workspace_t* workspace, int m, int n, int pivot_row, int pivot_col) {
+    if (pivot_row < 0 || pivot_row >= m || pivot_col < 0 || pivot_col >= n + m) return false;
+    for (int row = 0; row < m; row++) {
+        if (workspace->basis[row] == pivot_col) return false;
+    }
+    return true;
+}
+
+/**
+ * Pivots a freshly loaded tableau to a start basis. Pivots that are not
+ * valid yet or whose pivot element is too close to zero are retried after
+ * the others, since a slack only leaves its own row once that row pivots,
+ * until a pass takes none. Exactly one of the tableaus is given, and the
+ * exact one needs no tolerances.
+ *
+ * workspace: buffers tracking the basis
+ * tableau: tableau at the all slack basis, NULL if another one is given
+ * float_tableau: single precision tableau at the all slack basis, NULL if
+ *                another one is given
+ * exact_tableau: exact tableau at the all slack basis, NULL if another one
+ *                is given
+ * pool: pivot pool for the double or single precision tableau, NULL to
+ *       pivot serially
+ * start: pivots reaching the start basis
+ *
+ * return: if the basis reached is feasible
+ */
+bool warm_start_tableau(Workspace_t* workspace, Tableau_t* tableau, FloatTableau_t* float_tableau,
+                        ExactTableau_t* exact_tableau, PivotPool_t* pool, const SolveBasis_t* start) {
+    int m = (tableau != NULL)? tableau->s_size : (float_tableau != NULL)? float_tableau->s_size : exact_tableau->s_size;
+    int n = (tableau != NULL)? tableau->x_size : (float_tableau != NULL)? float_tableau->x_size : exact_tableau->x_size;
+    double tolerance = (tableau != NULL)? tableau->pivot_tolerance
+                     : (float_tableau != NULL)? float_tableau->pivot_tolerance : 0;
+    double feasibility = (tableau != NULL)? tableau->feasibility_tolerance
+                       : (float_tableau != NULL)? float_tableau->feasibility_tolerance : 0;
+
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (int index = 0; index < start->count; index++) {
+            int pivot_row = start->rows[index];
+            int pivot_col = start->cols[index];
+            if (!valid_start_pivot(workspace, m, n, pivot_row, pivot_col)) continue;
+            if (fabs(tableau_entry(tableau, float_tableau, exact_tableau, pivot_row, pivot_col)) <= tolerance) continue;
+
+            if (exact_tableau != NULL) {
+                if (!pivot_exact_tableau_at(exact_tableau, pivot_row, pivot_col)) return false;
+            }
+            else if (float_tableau != NULL) {
+                if (pool != NULL) pool_pivot_float_tableau_at(pool, float_tableau, pivot_row, pivot_col);
+                else pivot_float_tableau_at(float_tableau, pivot_row, pivot_col);
+            }
+            else if (pool != NULL) pool_pivot_tableau_at(pool, tableau, pivot_row, pivot_col);
+            else pivot_tableau_at(tableau, pivot_row, pivot_col);
+            record_pivot(workspace, pivot_row, pivot_col);
+            progress = true;
+        }
+    }
+
+    int rhs = n + m;
+    for (int row = 0; row < m; row++) {
+        if (tableau_entry(tableau, float_tableau, exact_tableau, row, rhs) < -feasibility) return false;
+    }
+    return true;
+}
+
+/**
+ * Checks if the basic variables of a revised simplex struct are nonnegative
+ *
+ * revised: struct to check
+ * tolerance: basic variables may be this far below zero
+ *
+ * return: if every basic variable is at least minus the tolerance
+ */
+bool feasible_revised(RevisedSimplex_t* revised, double tolerance) {
+    for (int pos = 0; pos < revised->m; pos++) {
+        if (revised->x_basic[pos] < -tolerance) return false;
+    }
+    return true;
+}
+
+/**
+ * Moves a freshly created revised simplex struct to a start basis and
+ * refactorizes it. Pivots that are not valid yet are retried like in
+ * warm_start_tableau.
+ *
+ * workspace: buffers tracking the basis
+ * revised: struct at the all slack basis
+ * start: pivots reaching the start basis
+ * tolerance: basic variables may be this far below zero in a feasible basis
+ *
+ * return: if the basis reached is nonsingular and feasible
+ */
+bool warm_start_revised(Workspace_t* workspace, RevisedSimplex_t* revised, const SolveBasis_t* start, double tolerance) {
+    int m = revised->m;
+    int n = revised->n;
+
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (int index = 0; index < start->count; index++) {
+            int pivot_row = start->rows[index];
+            int pivot_col = start->cols[index];
+            if (!valid_start_pivot(workspace, m, n, pivot_row, pivot_col)) continue;
+
+            revised->is_basic[revised->basis[pivot_row]] = false;
+            revised->is_basic[pivot_col] = true;
+            revised->basis[pivot_row] = pivot_col;
+            record_pivot(workspace, pivot_row, pivot_col);
+            progress = true;
+        }
+    }
+
+    return refactor_revised(revised) && feasible_revised(revised, tolerance);
+}
+
+/**
+ * Writes the basis tracked by a workspace as the pivots reaching it from the
+ * all slack basis, in the order their rows last pivoted
+ *
+ * workspace: buffers tracking the basis
+ * n: number of columns
+ * basis: filled with the pivots, its buffers must hold m pivots
+ */
+void export_basis(Workspace_t* workspace, int n, SolveBasis_t* basis) {
+    basis->count = 0;
+    for (int index = 0; index < workspace->sequence_count; index++) {
+        int row = workspace->sequence[index];
+        if (workspace->basis[row] == n + row) continue;
+
+        basis->rows[basis->count] = row;
+        basis->cols[basis->count++] = workspace->basis[row];
+    }
+}
+
+/**
+ * Gets the pivot pool a workspace keeps for a thread count, which is kept
+ * for later games with the same count
+ *
+ * workspace: buffers holding the pool
+ * threads: number of threads to pivot with
+ *
+ * return: pool, NULL for a single thread
+ */
+PivotPool_t* prepare_pool(Workspace_t* workspace, int threads) {
+    if (workspace->pool != NULL && workspace->pool->threads != threads) {
+        free_pivot_pool(workspace->pool);
+        workspace->pool = NULL;
+    }
+    if (workspace->pool == NULL && threads > 1) workspace->pool = create_pivot_pool(threads);
+    return workspace->pool;
+}
+
+/**
+ * Gets the blocked pivots a workspace keeps, reset for a tableau, when the
+ * options ask to block pivots of it
+ *
+ * workspace: buffers holding the blocked pivots
+ * tableau: double precision tableau to pivot
+ * pool: pivot pool for the tableau, NULL to pivot serially
+ * options: options holding the number of pivots to block
+ *
+ * return: blocked pivots, NULL to take every pivot in full, which a pool
+ *         and steepest edge pricing always do
+ */
+BlockedPivots_t* prepare_blocked_pivots(Workspace_t* workspace, Tableau_t* tableau, PivotPool_t* pool,
+                                        const SolveOptions_t* options) {
+    if (tableau == NULL || pool != NULL || options->block_pivots < 2 || options->rule == RULE_STEEPEST_EDGE) return NULL;
+    if (workspace->blocked == NULL) workspace->blocked = create_blocked_pivots();
+    int depth = (options->block_pivots < MAX_BLOCK_PIVOTS)? options->block_pivots : MAX_BLOCK_PIVOTS;
+    reset_blocked_pivots(workspace->blocked, tableau, depth);
+    return workspace->blocked;
+}
+
+/**
+ * Gets the pricing state a workspace keeps for a pivot rule, restarted for a
+ * new problem
+ *
+ * workspace: buffers holding the pricing state
+ * rule: pivot rule to use
+ * count: number of columns that can enter, payoff and slack
+ *
+ * return: pricing state with unit weights, NULL for dantzig's rule, which
+ *         needs no state
+ */
+Pricing_t* prepare_pricing(Workspace_t* workspace, PivotRule_t rule, int count) {
+    if (rule == RULE_DANTZIG) return NULL;
+
+    if (workspace->pricing != NULL && workspace->pricing->rule != rule) {
+        free_pricing(workspace->pricing);
+        workspace->pricing = NULL;
+    }
+    if (workspace->pricing == NULL) workspace->pricing = create_pricing(rule, count);
+    else reset_pricing(workspace->pricing, count);
+    workspace->pricing->basis = workspace->basis;
+    return workspace->pricing;
+}
+
+/**
+ * Gets the state for bland's rule that a solve switches to while its
+ * objective stalls
+ *
+ * workspace: buffers to keep the state in
+ * count: number of columns that can enter, payoff and slack
+ *
+ * return: pricing state for bland's rule
+ */
+Pricing_t* prepare_bland(Workspace_t* workspace, int count) {
+    if (workspace->bland == NULL) workspace->bland = create_pricing(RULE_BLAND, count);
+    else reset_pricing(workspace->bland, count);
+    workspace->bland->basis = workspace->basis;
+    return workspace->bland;
+}
+
+/**
+ * Hashes a column for the hash of a basis, which is the exclusive or of the
+ * hashes of its basic columns so a pivot updates it in constant time
+ *
+ * col: column to hash
+ *
+ * return: splitmix64 finalizer of the column
+ */
+static inline uint64_t column_hash(int col) {
+    uint64_t hash = (uint64_t) col + UINT64_C(0x9E3779B97F4A7C15);
+    hash = (hash ^ (hash >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    hash = (hash ^ (hash >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return hash ^ (hash >> 31);
+}
+
+/**
+ * Remembers a basis visited while the objective stalls, unless the stall
+ * already visited it, which means the pivots are cycling
+ *
+ * workspace: buffers holding the bases of the stall
+ * stalled: number of bases the stall visited so far
+ * hash: hash of the basis
+ *
+ * return: if the stall already visited the basis
+ */
+bool repeated_stall_basis(Workspace_t* workspace, int stalled, uint64_t hash) {
+    // a new stall empties the set by moving to the next generation, and a
+    // wrapped generation has to clear the slots it could match
+    if (stalled == 0 && ++workspace->stall_generation == 0) {
+        memset(workspace->stall_bases, 0, workspace->stall_capacity * sizeof(StallEntry_t));
+        workspace->stall_generation = 1;
+    }
+    unsigned generation = workspace->stall_generation;
+
+    // keep the set at most half full, moving the bases of this stall over
+    if (2 * (stalled + 1) > workspace->stall_capacity) {
+        int old_capacity = workspace->stall_capacity;
+        StallEntry_t* old_bases = workspace->stall_bases;
+        workspace->stall_capacity = (old_capacity > 0)? 2 * old_capacity : 64;
+        workspace->stall_bases = (StallEntry_t*) calloc(workspace->stall_capacity, sizeof(StallEntry_t));
+        uint64_t mask = workspace->stall_capacity - 1;
+        for (int index = 0; index < old_capacity; index++) {
+            if (old_bases[index].generation != generation) continue;
+            uint64_t slot = old_bases[index].hash & mask;
+            while (workspace->stall_bases[slot].generation == generation) slot = (slot + 1) & mask;
+            workspace->stall_bases[slot] = old_bases[index];
+        }
+        free(old_bases);
+    }
+
+    uint64_t mask = workspace->stall_capacity - 1;
+    uint64_t slot = hash & mask;
+    while (workspace->stall_bases[slot].generation == generation) {
+        if (workspace->stall_bases[slot].hash == hash) return true;
+        slot = (slot + 1) & mask;
+    }
+    workspace->stall_bases[slot].hash = hash;
+    workspace->stall_bases[slot].generation = generation;
+    return false;
+}
+
+/**
+ * Checks if the objective row of a tableau is nonnegative, so the dual
+ * simplex method can make it feasible
+ *
+ * tableau: struct to check
+ *
+ * return: if every reduced cost is at least minus the price tolerance
+ */
+bool dual_feasible_tableau(Tableau_t* tableau) {
+    double* objective_row = tableau->m[tableau->rows - 1];
+    for (int col = 0; col < tableau->cols - 1; col++) {
+        if (objective_row[col] < -PRICE_TOLERANCE) return false;
+    }
+    return true;
+}
+
+/**
+ * Runs the dual simplex method on a tableau whose objective row is
+ * nonnegative until its right hand side is too
+ *
+ * workspace: buffers tracking the basis
+ * tableau: struct to pivot
+ * pool: pivot pool, NULL to pivot serially
+ * pivot_count: increased by the number of pivots
+ *
+ * return: if the tableau became feasible
+ */
+bool run_dual_simplex(Workspace_t* workspace, Tableau_t* tableau, PivotPool_t* pool, int* pivot_count) {
+    PivotResult_t pivot_result;
+    while (true) {
+        select_dual_pivot(tableau, &pivot_result);
+        if (!pivot_result.success) return pivot_result.pivot_row < 0;
+
+        if (pool != NULL) pool_pivot_tableau_at(pool, tableau, pivot_result.pivot_row, pivot_result.pivot_col);
+        else pivot_tableau_at(tableau, pivot_result.pivot_row, pivot_result.pivot_col);
+        record_pivot(workspace, pivot_result.pivot_row, pivot_result.pivot_col);
+        (*pivot_count)++;
+    }
+}
+
+/**
+ * Runs the dual simplex method on a single precision tableau whose
+ * objective row is nonnegative, like run_dual_simplex
+ *
+ * workspace: buffers tracking the basis
+ * tableau: struct to pivot
+ * pool: pivot pool, NULL to pivot serially
+ * pivot_count: increased by the number of pivots
+ *
+ * return: if the tableau became feasible
+ */
+bool run_float_dual_simplex(Workspace_t* workspace, FloatTableau_t* tableau, PivotPool_t* pool, int* pivot_count) {
+    PivotResult_t pivot_result;
+    while (true) {
+        select_float_dual_pivot(tableau, &pivot_result);
+        if (!pivot_result.success) return pivot_result.pivot_row < 0;
+
+        if (pool != NULL) pool_pivot_float_tableau_at(pool, tableau, pivot_result.pivot_row, pivot_result.pivot_col);
+        else pivot_float_tableau_at(tableau, pivot_result.pivot_row, pivot_result.pivot_col);
+        record_pivot(workspace, pivot_result.pivot_row, pivot_result.pivot_col);
+        (*pivot_count)++;
+    }
+}
+
+/**
+ * Checks if the reduced costs of a revised simplex struct are nonnegative,
+ * like dual_feasible_tableau
+ *
+ * revised: struct to check, its duals are updated
+ *
+ * return: if every reduced cost is at least minus the price tolerance
+ */
+bool dual_feasible_revised(RevisedSimplex_t* revised) {
+    update_revised_duals(revised);
+    for (int col = 0; col < revised->n + revised->m; col++) {
+        if (revised_price(revised, col) < -PRICE_TOLERANCE) return false;
+    }
+    return true;
+}
+
+/**
+ * Runs the dual simplex method on a revised simplex struct whose reduced
+ * costs are nonnegative until its basic variables are too, like
+ * run_dual_simplex
+ *
+ * workspace: buffers tracking the basis
+ * revised: struct to pivot
+ * pivot_count: increased by the number of pivots
+ *
+ * return: if the basis became feasible
+ */
+bool run_dual_revised(Workspace_t* workspace, RevisedSimplex_t* revised, int* pivot_count) {
+    PivotResult_t pivot_result;
+    while (true) {
+        dual_pivot_revised(revised, &pivot_result);
+        if (!pivot_result.success) return pivot_result.pivot_row < 0;
+
+        record_pivot(workspace, pivot_result.pivot_row, pivot_result.pivot_col);
+        (*pivot_count)++;
+    }
+}
+
+/**
+ * Reads a clock that only moves forward
+ *
+ * return: seconds since some fixed point
+ */
+static double monotonic_seconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+/**
+ * Starts the pivot and time limits of a solve, which cover every phase of it,
+ * and its timings and stats
+ *
+ * workspace: buffers to solve in
+ * options: options holding the limits
+ */
+void start_solve(Workspace_t* workspace, const SolveOptions_t* options) {
+    workspace->pivot_budget = (options->max_pivots > 0)? options->max_pivots : INT_MAX;
+    workspace->deadline = (options->time_limit > 0)? monotonic_seconds() + options->time_limit : 0;
+    workspace->status = SOLVE_OPTIMAL;
+    workspace->timed = options->timings != NULL;
+    workspace->timings = (workspace->timed)? options->timings : &workspace->untimed;
+    memset(workspace->timings, 0, sizeof(SolveTimings_t));
+    if (options->stats != NULL) memset(options->stats, 0, sizeof(SolveStats_t));
+#ifdef SIMPLEX_STATS
+    stats = options->stats;
+#endif
+}
+
+/**
+ * Ends a solve started with start_solve, so nothing counts toward the
+ * caller's timings and stats after it returns
+ *
+ * workspace: buffers solved in
+ */
+void finish_solve(Workspace_t* workspace) {
+    workspace->timed = false;
+    workspace->timings = &workspace->untimed;
+#ifdef SIMPLEX_STATS
+    stats = NULL;
+#endif
+}
+
+/**
+ * Starts timing a phase of the current solve, reading the clock only when
+ * the solve is timed
+ *
+ * workspace: buffers solving
+ *
+ * return: time the phase started, 0 if the solve is not timed
+ */
+static inline double start_phase(Workspace_t* workspace) {
+    return (workspace->timed)? monotonic_seconds() : 0;
+}
+
+/**
+ * Ends timing a phase of the current solve
+ *
+ * workspace: buffers solving
+ * phase: time spent in the phase, grown by the time since start
+ * start: time the phase started, from start_phase
+ *
+ * return: time since start, 0 if the solve is not timed
+ */
+static inline double end_phase(Workspace_t* workspace, double* phase, double start) {
+    if (!workspace->timed) return 0;
+    double seconds = monotonic_seconds() - start;
+    *phase += seconds;
+    return seconds;
+}
+
+/**
+ * Gets the objective of whichever engine is solving, which the primal
+ * simplex method never decreases
+ *
+ * tableau: double precision tableau, NULL if another engine is given
+ * float_tableau: single precision tableau, NULL if another engine is given
+ * exact_tableau: exact tableau, NULL if another engine is given
+ * revised: revised simplex struct, NULL if another engine is given
+ *
+ * return: objective, V
+ */
+double engine_objective(Tableau_t* tableau, FloatTableau_t* float_tableau, ExactTableau_t* exact_tableau,
+                        RevisedSimplex_t* revised) {
+    if (revised != NULL) return revised_objective(revised);
+    int s_size = (tableau != NULL)? tableau->s_size : (float_tableau != NULL)? float_tableau->s_size : exact_tableau->s_size;
+    int cols = (tableau != NULL)? tableau->cols : (float_tableau != NULL)? float_tableau->cols : exact_tableau->cols;
+    return tableau_entry(tableau, float_tableau, exact_tableau, s_size, cols - 1);
+}
+
+/**
+ * Checks if no column of whichever engine is solving can enter, with the
+ * price tolerance of its pivots
+ *
+ * tableau: double precision tableau, NULL if another engine is given
+ * float_tableau: single precision tableau, NULL if another engine is given
+ * exact_tableau: exact tableau, NULL if another engine is given
+ * revised: revised simplex struct, NULL if another engine is given
+ *
+ * return: if the basis is optimal
+ */
+bool engine_optimal(Tableau_t* tableau, FloatTableau_t* float_tableau, ExactTableau_t* exact_tableau,
+                    RevisedSimplex_t* revised) {
+    if (revised != NULL) {
+        for (int col = 0; col < revised->n + revised->m; col++) {
+            if (revised_price(revised, col) < -PRICE_TOLERANCE) return false;
+        }
+        return true;
+    }
+
+    int s_size = (tableau != NULL)? tableau->s_size : (float_tableau != NULL)? float_tableau->s_size : exact_tableau->s_size;
+    int cols = (tableau != NULL)? tableau->cols : (float_tableau != NULL)? float_tableau->cols : exact_tableau->cols;
+    double tolerance = (float_tableau != NULL)? FLOAT_PRICE_TOLERANCE : 0;
+    for (int col = 0; col < cols - 1; col++) {
+        if (tableau_entry(tableau, float_tableau, exact_tableau, s_size, col) < -tolerance) return false;
+    }
+    return true;
+}
+
+/**
+ * Restarts the weights of a pivot rule after pivots taken with another one,
+ * as at the start of a solve
+ *
+ * pricing: pivot rule state, NULL for dantzig's rule
+ * tableau: double precision tableau, NULL if another engine is given
+ * float_tableau: single precision tableau, NULL if another engine is given
+ * exact_tableau: exact tableau, NULL if another engine is given
+ * revised: revised simplex struct, NULL if another engine is given
+ */
+void restart_pricing(Pricing_t* pricing, Tableau_t* tableau, FloatTableau_t* float_tableau,
+                     ExactTableau_t* exact_tableau, RevisedSimplex_t* revised) {
+    if (pricing == NULL) return;
+    reset_pricing(pricing, pricing->count);
+    if (revised != NULL) init_revised_pricing(pricing, revised);
+    else if (float_tableau != NULL) update_float_tableau_pricing(pricing, float_tableau, -1, -1);
+    else if (exact_tableau != NULL) update_exact_tableau_pricing(pricing, exact_tableau, -1, -1);
+    else update_tableau_pricing(pricing, tableau, -1, -1);
+}
+
+/**
+ * Runs the primal simplex method until no column can enter, printing the
+ * trace the options ask for along the way. Exactly one of the engines is
+ * given. When pivots that do not grow the objective return to a basis they
+ * already visited, which is how cycling on a degenerate game shows, bland's
+ * rule takes over until it grows again. The solve stops short of the optimum at the pivot and time
+ * limits of the workspace, setting its status.
+ *
+ * workspace: buffers tracking the basis
+ * tableau: tableau to pivot, NULL if another engine is given
+ * float_tableau: single precision tableau to pivot, NULL if another engine
+ *                is given
+ * exact_tableau: exact tableau to pivot, NULL if another engine is given
+ * revised: revised simplex struct to pivot, NULL if another engine is given
+ * pool: pivot pool for the double or single precision tableau, NULL to
+ *       pivot serially
+ * blocked: deferred pivots of the double precision tableau, NULL to take
+ *          every pivot in full. They are all applied before returning.
+ * pricing: pivot rule state, NULL for dantzig's rule
+ * n: number of columns
+ * options: options holding the trace settings
+ *
+ * return: number of pivots
+ */
+int run_simplex(Workspace_t* workspace, Tableau_t* tableau, FloatTableau_t* float_tableau,
+                ExactTableau_t* exact_tableau, RevisedSimplex_t* revised, PivotPool_t* pool, BlockedPivots_t* blocked,
+                Pricing_t* pricing, int n, const SolveOptions_t* options) {
+    FILE* trace = (options->trace_every > 0)? options->trace : NULL;
+    int trace_every = options->trace_every;
+    bool printable = revised == NULL;
+
+    int pivot_count = 0;
+    PivotResult_t pivot_result;
+    bool traced = false;
+
+    Pricing_t* active = pricing;
+    int count = (revised != NULL)? revised->n + revised->m : n + ((tableau != NULL)? tableau->s_size
+                : (float_tableau != NULL)? float_tableau->s_size : exact_tableau->s_size);
+    double objective = engine_objective(tableau, float_tableau, exact_tableau, revised);
+    double stall_tolerance = (float_tableau != NULL)? FLOAT_STALL_TOLERANCE : STALL_TOLERANCE;
+    int stalled = 0;
+    bool perturbed = false;
+    uint64_t basis_hash = 0;
+    int rows = (revised != NULL)? revised->m : count - n;
+    for (int row = 0; row < rows; row++) basis_hash ^= column_hash(workspace->basis[row]);
+    while (true) {
+        // print tableau, the revised engine does not have one
+        traced = trace != NULL && pivot_count % trace_every == 0;
+        if (traced && printable) {
+            if (pivot_count == 0) fprintf(trace, "Initial Tableau:\n");
+            else fprintf(trace, "Tableau %d:\n", pivot_count);
+            if (float_tableau != NULL) print_float_tableau(trace, float_tableau);
+            else if (exact_tableau != NULL) print_exact_tableau(trace, exact_tableau);
+            else {
+                if (blocked != NULL) flush_blocked_pivots(blocked, tableau);
+                print_tableau(trace, tableau);
+            }
+        }
+
+        // stop at a limit, unless there is nothing left to do anyway
+        bool limited = workspace->pivot_budget <= 0 || (workspace->deadline > 0 && monotonic_seconds() >= workspace->deadline);
+        if (limited && !engine_optimal(tableau, float_tableau, exact_tableau, revised)) {
+            workspace->status = (workspace->pivot_budget <= 0)? SOLVE_PIVOT_LIMIT : SOLVE_TIME_LIMIT;
+            break;
+        }
+
+        // pivot it in place
+        double start = start_phase(workspace);
+        if (revised != NULL) pivot_revised(revised, active, &pivot_result);
+        else if (exact_tableau != NULL) pivot_exact_tableau(exact_tableau, active, &pivot_result);
+        else if (float_tableau != NULL && pool != NULL) pool_pivot_float_tableau(pool, float_tableau, active, &pivot_result);
+        else if (float_tableau != NULL) pivot_float_tableau(float_tableau, active, &pivot_result);
+        else if (pool != NULL) pool_pivot_tableau(pool, tableau, active, &pivot_result);
+        else if (blocked != NULL) pivot_blocked_tableau(blocked, tableau, active, &pivot_result);
+        else pivot_tableau(tableau, active, &pivot_result);
+        double seconds = end_phase(workspace, &workspace->timings->pivot, start);
+        workspace->timings->slowest_pivot = fmax(workspace->timings->slowest_pivot, seconds);
+        if (pivot_result.success) {
+            if (traced) fprintf(trace, "Pivot: ( %d, %d )\n\n", pivot_result.pivot_row, pivot_result.pivot_col);
+            basis_hash ^= column_hash(workspace->basis[pivot_result.pivot_row]) ^ column_hash(pivot_result.pivot_col);
+            record_pivot(workspace, pivot_result.pivot_row, pivot_result.pivot_col);
+        }
+        else break;
+
+        pivot_count++;
+        workspace->pivot_budget--;
+
+        // switch to bland's rule once the pivots of a stall cycle, and back
+        // once the objective grows
+        double value = engine_objective(tableau, float_tableau, exact_tableau, revised);
+        if (value > objective + stall_tolerance * fabs(objective)) {
+            objective = value;
+            stalled = 0;
+            if (active != pricing) {
+                active = pricing;
+                restart_pricing(pricing, tableau, float_tableau, exact_tableau, revised);
+            }
+        }
+        else {
+            // a degenerate pivot gains nothing, so the kept candidates of
+            // multiple pricing are no better than any other column and the
+            // next pivot scans them all
+            if (active != NULL && active->rule == RULE_MULTIPLE) active->candidate_count = 0;
+            STATS_ADD(degenerate_pivots, 1);
+
+            // bland's rule cannot cycle in exact arithmetic, but rounding
+            // can make a single precision tableau cycle under it too, which
+            // perturbing the degenerate rows stops
+            if (repeated_stall_basis(workspace, stalled++, basis_hash)) {
+                if (active == NULL || active->rule != RULE_BLAND) {
+                    active = prepare_bland(workspace, count);
+                    stalled = 0;
+                }
+                else if (float_tableau != NULL) {
+                    perturbed = perturb_float_tableau(float_tableau, workspace->basis) || perturbed;
+                }
+            }
+        }
+    }
+
+    // the reduced costs do not depend on the right hand side, so the basis
+    // stays optimal without the perturbation, and the dual simplex method
+    // repairs any row it leaves infeasible
+    if (perturbed) {
+        restore_float_tableau_rhs(float_tableau);
+        run_float_dual_simplex(workspace, float_tableau, pool, &pivot_count);
+    }
+
+    // the final tableau is always part of a trace
+    if (blocked != NULL) flush_blocked_pivots(blocked, tableau);
+    if (trace != NULL && !traced && printable) {
+        fprintf(trace, "Tableau %d:\n", pivot_count);
+        if (float_tableau != NULL) print_float_tableau(trace, float_tableau);
+        else if (exact_tableau != NULL) print_exact_tableau(trace, exact_tableau);
+        else print_tableau(trace, tableau);
+    }
+    return pivot_count;
+}
+
+/**
+ * Reads the strategies and value of a game from the final tableau or
+ * revised simplex struct, and exports the basis if asked to. Exactly one of
+ * the engines is given.
+ *
+ * workspace: buffers tracking the basis
+ * tableau: final tableau, NULL if another engine is given
+ * float_tableau: final single precision tableau, NULL if another engine is
+ *                given
+ * revised: final revised simplex struct, NULL if another engine is given
+ * m: number of rows
+ * n: number of columns
+ * result: filled with the solution, apart from the pivot count
+ */
+void read_solution(Workspace_t* workspace, Tableau_t* tableau, FloatTableau_t* float_tableau, RevisedSimplex_t* revised,
+                   int m, int n, SolveResult_t* result) {
+    const int* basis = workspace->basis;
+    int rhs = n + m;
+
+    // process the final tableau and determine strategies and value
+    // note: tableau is the final tableau, for the revised engine its
+    // objective row and right hand side are read from the basis
+    double v = (revised != NULL)? revised_objective(revised) : tableau_entry(tableau, float_tableau, NULL, m, rhs); // V
+    double k = (revised != NULL)? revised->k : (tableau != NULL)? tableau->k : float_tableau->k;
+    result->value = (1 / v) - k; // calculate value of the game
+
+    // calculate p1 strategy
+    for (int index = 0; index < m; index++) {
+        double dual = (revised != NULL)? revised->duals[index] : tableau_entry(tableau, float_tableau, NULL, m, n + index);
+        result->p1_strategy[index] = dual / v;
+    }
+
+    // calculate p2 strategy, the nonbasic columns are 0
+    for (int index = 0; index < n; index++) result->p2_strategy[index] = 0;
+    for (int row = 0; row < m; row++) {
+        int col = basis[row];
+        if (col >= n) continue;
+        if (revised != NULL) result->p2_strategy[col] = revised->x_basic[row] / v;
+        else result->p2_strategy[col] = tableau_entry(tableau, float_tableau, NULL, row, rhs) / v;
+    }
+
+    result->exact = false;
+    result->value_numerator = 0;
+    result->value_denominator = 0;
+    if (result->basis.rows != NULL) export_basis(workspace, n, &result->basis);
+    result->status = SOLVE_OPTIMAL;
+    result->success = true;
+}
+
+/**
+ * Fills the result of a solve that stopped at a limit of the workspace
+ * short of the optimum. Only the final basis is exported, as a start for
+ * another solve.
+ *
+ * workspace: buffers tracking the basis
+ * n: number of columns
+ * result: filled with the status, apart from the pivot count
+ */
+void stop_at_limit(Workspace_t* workspace, int n, SolveResult_t* result) {
+    result->exact = false;
+    result->value_numerator = 0;
+    result->value_denominator = 0;
+    if (result->basis.rows != NULL) export_basis(workspace, n, &result->basis);
+    result->status = workspace->status;
+    result->success = false;
+}
+
+/**
+ * Sets the ratio test tolerances of whichever engine is solving from the
+ * options, keeping the defaults of its precision for those given as 0
+ *
+ * options: options to solve with
+ * tableau: double precision tableau, NULL if another engine is given
+ * float_tableau: single precision tableau, NULL if another engine is given
+ * revised: revised simplex struct, NULL if another engine is given
+ */
+void apply_tolerances(const SolveOptions_t* options, Tableau_t* tableau, FloatTableau_t* float_tableau,
+                      RevisedSimplex_t* revised) {
+    double pivot = options->pivot_tolerance;
+    double feasibility = options->feasibility_tolerance;
+    if (tableau != NULL) {
+        tableau->pivot_tolerance = (pivot > 0)? pivot : PIVOT_TOLERANCE;
+        tableau->feasibility_tolerance = (feasibility > 0)? feasibility : FEASIBILITY_TOLERANCE;
+    }
+    if (float_tableau != NULL) {
+        float_tableau->pivot_tolerance = (pivot > 0)? pivot : FLOAT_PIVOT_TOLERANCE;
+        float_tableau->feasibility_tolerance = (feasibility > 0)? feasibility : FLOAT_FEASIBILITY_TOLERANCE;
+    }
+    if (revised != NULL) {
+        revised->pivot_tolerance = (pivot > 0)? pivot : PIVOT_TOLERANCE;
+        revised->feasibility_tolerance = (feasibility > 0)? feasibility : FEASIBILITY_TOLERANCE;
+    }
+}
+
+bool solve_mixed_in_workspace(Workspace_t* workspace, const void* payoff, Dtype_t dtype, SparseMatrix_t* matrix,
+                              int m, int n, const SolveOptions_t* options, SolveResult_t* result);
+bool solve_exact_in_workspace(Workspace_t* workspace, const void* payoff, Dtype_t dtype, SparseMatrix_t* matrix,
+                              int m, int n, const SolveOptions_t* options, SolveResult_t* result);
+
+/**
+ * Solves a game with the simplex method, printing the trace the options ask
+ * for along the way. The payoff matrix is given either dense or sparse.
+ *
+ * workspace: buffers to solve in
+ * payoff: row-major payoff matrix, NULL if matrix is given
+ * dtype: type of the entries of payoff
+ * matrix: sparse payoff matrix, NULL if payoff is given
+ * m: number of rows
+ * n: number of columns
+ * options: options to solve with
+ * result: filled with the solution
+ *
+ * return: result->success
+ */
+bool solve_in_workspace(Workspace_t* workspace, const void* payoff, Dtype_t dtype, SparseMatrix_t* matrix,
+                        int m, int n, const SolveOptions_t* options, SolveResult_t* result) {
+    if (options->engine == ENGINE_TABLEAU && options->precision == PRECISION_MIXED)
+        return solve_mixed_in_workspace(workspace, payoff, dtype, matrix, m, n, options, result);
+    if (options->engine == ENGINE_TABLEAU && options->precision == PRECISION_EXACT)
+        return solve_exact_in_workspace(workspace, payoff, dtype, matrix, m, n, options, result);
+
+    // keep track of the basis
+    double start = start_phase(workspace);
+    STATS_START(build_start);
+    reset_basis_tracking(workspace, m, n);
+
+    // exactly one of the engines is used
+    Tableau_t* tableau = NULL;
+    FloatTableau_t* float_tableau = NULL;
+    RevisedSimplex_t* revised = NULL;
+    PivotPool_t* pool = NULL;
+    SparseMatrix_t* built = NULL; // sparse form built here, if any
+    double* dense = NULL; // dense form built here, if any
+    if (options->engine == ENGINE_REVISED) {
+        if (matrix == NULL) matrix = built = dense_to_sparse(payoff, dtype, m, n);
+        revised = create_revised(matrix);
+    }
+    else {
+        if (payoff == NULL) {
+            payoff = dense = sparse_to_dense(matrix);
+            dtype = DTYPE_FLOAT64;
+        }
+
+        if (options->precision == PRECISION_FLOAT) {
+            if (workspace->float_tableau == NULL) workspace->float_tableau = create_float_tableau(m, n);
+            else reset_float_tableau(workspace->float_tableau, m, n);
+            float_tableau = workspace->float_tableau;
+            load_float_tableau(float_tableau, payoff, dtype, m, n);
+        }
+        else {
+            // the directory is set before the tableau is shaped, so a tableau
+            // too large for memory is never allocated there
+            if (workspace->tableau == NULL) workspace->tableau = create_tableau(0, 0);
+            workspace->tableau->dir = options->tableau_dir;
+            reset_tableau(workspace->tableau, m, n);
+            tableau = workspace->tableau;
+            load_init_tableau(tableau, payoff, dtype, m, n);
+        }
+        pool = prepare_pool(workspace, options->threads);
+    }
+    apply_tolerances(options, tableau, float_tableau, revised);
+
+    // move to the start basis. a double tableau that is not feasible there
+    // but still optimal for the objective is repaired with the dual simplex
+    // method, anything else goes back to the all slack basis
+    int pivot_count = 0;
+    result->warm_started = false;
+    if (options->start != NULL) {
+        if (revised != NULL) result->warm_started = warm_start_revised(workspace, revised, options->start, revised->feasibility_tolerance);
+        else {
+            result->warm_started = warm_start_tableau(workspace, tableau, float_tableau, NULL, pool, options->start);
+            if (!result->warm_started && tableau != NULL && dual_feasible_tableau(tableau))
+                result->warm_started = run_dual_simplex(workspace, tableau, pool, &pivot_count);
+        }
+
+        if (!result->warm_started) {
+            pivot_count = 0;
+            reset_basis_tracking(workspace, m, n);
+            if (revised != NULL) {
+                free_revised(revised);
+                revised = create_revised(matrix);
+                apply_tolerances(options, NULL, NULL, revised);
+            }
+            else if (float_tableau != NULL) {
+                reset_float_tableau(float_tableau, m, n);
+                load_float_tableau(float_tableau, payoff, dtype, m, n);
+            }
+            else {
+                reset_tableau(tableau, m, n);
+                load_init_tableau(tableau, payoff, dtype, m, n);
+            }
+        }
+    }
+
+    result->out_of_core = tableau != NULL && tableau->fd >= 0;
+    Pricing_t* pricing = prepare_pricing(workspace, options->rule, n + m);
+    if (pricing != NULL) {
+        // weights of a warm started revised engine restart from 1, like
+        // devex reference weights
+        if (revised != NULL && !result->warm_started) init_revised_pricing(pricing, revised);
+        else if (float_tableau != NULL) update_float_tableau_pricing(pricing, float_tableau, -1, -1);
+        else if (tableau != NULL) update_tableau_pricing(pricing, tableau, -1, -1);
+    }
+    BlockedPivots_t* blocked = prepare_blocked_pivots(workspace, tableau, pool, options);
+    end_phase(workspace, &workspace->timings->build, start);
+    STATS_CYCLES(build_cycles, build_start);
+
+    pivot_count += run_simplex(workspace, tableau, float_tableau, NULL, revised, pool, blocked, pricing, n, options);
+    start = start_phase(workspace);
+    STATS_START(extract_start);
+    if (workspace->status == SOLVE_OPTIMAL) read_solution(workspace, tableau, float_tableau, revised, m, n, result);
+    else stop_at_limit(workspace, n, result);
+    end_phase(workspace, &workspace->timings->extract, start);
+    STATS_CYCLES(extract_cycles, extract_start);
+    result->pivots = pivot_count;
+
+    workspace->solved = tableau != NULL && result->success;
+    workspace->m = m;
+    workspace->n = n;
+
+    if (revised != NULL) free_revised(revised);
+    if (built != NULL) free_sparse_matrix(built);
+    free(dense);
+    return result->success;
+}
+
+/**
+ * Refines a basis found in single precision with the revised simplex method
+ * in double precision. Factorizing the basis checks it, and when it already
+ * is optimal no pivot is taken.
+ *
+ * workspace: buffers to solve in
+ * payoff: row-major payoff matrix, NULL if matrix is given
+ * dtype: type of the entries of payoff
+ * matrix: sparse payoff matrix, NULL if payoff is given
+ * m: number of rows
+ * n: number of columns
+ * options: options to solve with, start holding the basis to refine
+ * result: filled with the solution
+ *
+ * return: if the basis was nonsingular, close enough to feasible to refine
+ *         and still feasible at the end, result is only filled in that case
+ */
+bool refine_in_workspace(Workspace_t* workspace, const void* payoff, Dtype_t dtype, SparseMatrix_t* matrix,
+                         int m, int n, const SolveOptions_t* options, SolveResult_t* result) {
+    double start = start_phase(workspace);
+    STATS_START(build_start);
+    reset_basis_tracking(workspace, m, n);
+
+    SparseMatrix_t* built = NULL;
+    if (matrix == NULL) matrix = built = dense_to_sparse(payoff, dtype, m, n);
+    RevisedSimplex_t* revised = create_revised(matrix);
+    apply_tolerances(options, NULL, NULL, revised);
+
+    // rounding can leave basic variables slightly negative. the dual simplex
+    // method moves them back to zero when the basis is still optimal in
+    // double precision, and otherwise the basis is left to the caller
+    int pivot_count = 0;
+    bool refined = warm_start_revised(workspace, revised, options->start, MIXED_FEASIBILITY_TOLERANCE);
+    if (refined && !feasible_revised(revised, revised->feasibility_tolerance))
+        refined = dual_feasible_revised(revised) && run_dual_revised(workspace, revised, &pivot_count);
+    end_phase(workspace, &workspace->timings->build, start);
+    STATS_CYCLES(build_cycles, build_start);
+    if (refined) {
+        Pricing_t* pricing = prepare_pricing(workspace, options->rule, n + m);
+        pivot_count += run_simplex(workspace, NULL, NULL, NULL, revised, NULL, NULL, pricing, n, options);
+        start = start_phase(workspace);
+        STATS_START(extract_start);
+
+        // the solution is read from a fresh factorization, so rounding in the
+        // eta columns cannot leave it infeasible
+        if (workspace->status != SOLVE_OPTIMAL) stop_at_limit(workspace, n, result);
+        else if (refactor_revised(revised) && feasible_revised(revised, revised->feasibility_tolerance)) {
+            update_revised_duals(revised);
+            read_solution(workspace, NULL, NULL, revised, m, n, result);
+        }
+        else refined = false;
+        result->pivots = pivot_count;
+        end_phase(workspace, &workspace->timings->extract, start);
+        STATS_CYCLES(extract_cycles, extract_start);
+        workspace->solved = false;
+        workspace->m = m;
+        workspace->n = n;
+    }
+
+    free_revised(revised);
+    if (built != NULL) free_sparse_matrix(built);
+    return refined;
+}
+
+/**
+ * Checks the strategies of a solution against its game. Each has to be a
+ * distribution, and has to hold the value against every pure strategy of
+ * the other player.
+ *
+ * payoff: row-major payoff matrix, NULL if matrix is given
+ * dtype: type of the entries of payoff
+ * matrix: sparse payoff matrix, NULL if payoff is given
+ * m: number of rows
+ * n: number of columns
+ * result: solution to check
+ * tolerance: allowed error of the sums, and of the guarantees relative to
+ *            the largest payoff
+ *
+ * return: if the solution holds
+ */
+bool verify_solution(const void* payoff, Dtype_t dtype, const SparseMatrix_t* matrix, int m, int n,
+                     const SolveResult_t* result, double tolerance) {
+    const double* p1 = result->p1_strategy;
+    const double* p2 = result->p2_strategy;
+    double p1_sum = 0;
+    double p2_sum = 0;
+    for (int row = 0; row < m; row++) {
+        if (p1[row] < -tolerance) return false;
+        p1_sum += p1[row];
+    }
+    for (int col = 0; col < n; col++) {
+        if (p2[col] < -tolerance) return false;
+        p2_sum += p2[col];
+    }
+    if (fabs(p1_sum - 1) > tolerance || fabs(p2_sum - 1) > tolerance) return false;
+
+    // payoff of p1 against each column, and of each row against p2
+    double* col_payoff = (double*) calloc(n, sizeof(double));
+    double* row_payoff = (double*) calloc(m, sizeof(double));
+    double scale = 0;
+    if (matrix != NULL) {
+        for (int col = 0; col < n; col++) {
+            for (size_t index = matrix->col_start[col]; index < matrix->col_start[col + 1]; index++) {
+                int row = matrix->row_index[index];
+                double value = matrix->values[index];
+                col_payoff[col] += p1[row] * value;
+                row_payoff[row] += value * p2[col];
+                scale = fmax(scale, fabs(value));
+            }
+        }
+    }
+    else {
+        for (int row = 0; row < m; row++) {
+            for (int col = 0; col < n; col++) {
+                double value = payoff_entry(payoff, dtype, (size_t) row * n + col);
+                col_payoff[col] += p1[row] * value;
+                row_payoff[row] += value * p2[col];
+                scale = fmax(scale, fabs(value));
+            }
+        }
+    }
+
+    bool holds = true;
+    double allowed = tolerance * scale;
+    for (int col = 0; col < n && holds; col++) holds = col_payoff[col] >= result->value - allowed;
+    for (int row = 0; row < m && holds; row++) holds = row_payoff[row] <= result->value + allowed;
+    free(col_payoff);
+    free(row_payoff);
+    return holds;
+}
+
+/**
+ * Solves a game in mixed precision. The single precision tableau does the
+ * pivots, whose cost is in streaming the tableau through memory, and its
+ * final basis is refined in double precision by refine_in_workspace. A
+ * basis too far off for that, or whose refined strategies do not hold
+ * against the game, is repaired by the double tableau starting from it
+ * instead.
+ *
+ * workspace: buffers to solve in
+ * payoff: row-major payoff matrix, NULL if matrix is given
+ * dtype: type of the entries of payoff
+ * matrix: sparse payoff matrix, NULL if payoff is given
+ * m: number of rows
+ * n: number of columns
+ * options: options to solve with
+ * result: filled with the solution
+ *
+ * return: result->success
+ */
+bool solve_mixed_in_workspace(Workspace_t* workspace, const void* payoff, Dtype_t dtype, SparseMatrix_t* matrix,
+                              int m, int n, const SolveOptions_t* options, SolveResult_t* result) {
+    SolveOptions_t phase = *options;
+    phase.precision = PRECISION_FLOAT;
+    if (!solve_in_workspace(workspace, payoff, dtype, matrix, m, n, &phase, result)) return false;
+    int pivot_count = result->pivots;
+    bool warm_started = result->warm_started;
+
+    SolveBasis_t basis = { 0, workspace->refine_rows, workspace->refine_cols };
+    export_basis(workspace, n, &basis);
+
+    // the trace shows the single precision tableaus
+    phase.precision = PRECISION_DOUBLE;
+    phase.trace_every = 0;
+    phase.start = &basis;
+    bool refined = refine_in_workspace(workspace, payoff, dtype, matrix, m, n, &phase, result);
+    if (!refined || (result->success && !verify_solution(payoff, dtype, matrix, m, n, result, MIXED_VERIFY_TOLERANCE)))
+        solve_in_workspace(workspace, payoff, dtype, matrix, m, n, &phase, result);
+
+    result->pivots += pivot_count;
+    result->warm_started = warm_started;
+    return result->success;
+}
+
+/**
+ * Divides one entry of an exact tableau by another, rounding only the
+ * quotient to a double
+ *
+ * tableau: struct to index
+ * row: row of the dividend
+ * col: column of the dividend
+ * by_row: row of the divisor
+ * by_col: column of the divisor, which must not be zero
+ *
+ * return: quotient
+ */
+static double exact_entry_ratio(ExactTableau_t* tableau, int row, int col, int by_row, int by_col) {
+    if (tableau->limbs == 0) {
+        return (double) tableau->data[(size_t) row * tableau->stride + col] /
+               (double) tableau->data[(size_t) by_row * tableau->stride + by_col];
+    }
+    return limbs_ratio(exact_wide_entry(tableau, row, col), exact_wide_entry(tableau, by_row, by_col), tableau->limbs);
+}
+
+/**
+ * Reads the strategies and value of a game from a final exact tableau. Each
+ * is a ratio of two integers of the tableau, rounded to a double only at the
+ * end, and the value is also kept as a fraction in lowest terms when it
+ * fits in 64 bits.
+ *
+ * workspace: buffers tracking the basis
+ * tableau: final exact tableau
+ * m: number of rows
+ * n: number of columns
+ * result: filled with the solution, apart from the pivot count
+ */
+void read_exact_solution(Workspace_t* workspace, ExactTableau_t* tableau, int m, int n, SolveResult_t* result) {
+    const int* basis = workspace->basis;
+    int rhs = n + m;
+
+    // V is v over the denominator, so the value is denominator / v - k
+    __int128 v, denominator, numerator, shifted;
+    bool fits;
+    if (tableau->limbs == 0) {
+        v = tableau->data[(size_t) m * tableau->stride + rhs];
+        denominator = tableau->denominator;
+        fits = true;
+    }
+    else {
+        fits = limbs_to_int128(exact_wide_entry(tableau, m, rhs), tableau->limbs, &v) &&
+               limbs_to_int128(tableau->work, tableau->limbs, &denominator);
+    }
+
+    result->value_numerator = 0;
+    result->value_denominator = 0;
+    if (fits && !__builtin_mul_overflow(v, (__int128) tableau->k, &shifted) &&
+        !__builtin_sub_overflow(denominator, shifted, &numerator)) {
+        __int128 a = (numerator < 0)? -numerator : numerator;
+        __int128 b = v;
+        while (b != 0) {
+            __int128 remainder = a % b;
+            a = b;
+            b = remainder;
+        }
+        numerator /= a;
+        denominator = v / a;
+        result->value = (double) numerator / (double) denominator;
+        if (numerator > INT64_MIN && numerator <= INT64_MAX && denominator <= INT64_MAX) {
+            result->value_numerator = (long long) numerator;
+            result->value_denominator = (long long) denominator;
+        }
+    }
+    else if (tableau->limbs == 0) {
+        result->value = (double) tableau->denominator / (double) v - tableau->k;
+    }
+    else {
+        result->value = limbs_ratio(tableau->work, exact_wide_entry(tableau, m, rhs), tableau->limbs) - tableau->k;
+    }
+
+    // calculate p1 strategy
+    for (int index = 0; index < m; index++)
+        result->p1_strategy[index] = exact_entry_ratio(tableau, m, n + index, m, rhs);
+
+    // calculate p2 strategy, the nonbasic columns are 0
+    for (int index = 0; index < n; index++) result->p2_strategy[index] = 0;
+    for (int row = 0; row < m; row++) {
+        if (basis[row] < n) result->p2_strategy[basis[row]] = exact_entry_ratio(tableau, row, rhs, m, rhs);
+    }
+
+    result->exact = true;
+    if (result->basis.rows != NULL) export_basis(workspace, n, &result->basis);
+    result->status = SOLVE_OPTIMAL;
+    result->success = true;
+}
+
+/**
+ * Solves a game with integer payoffs exactly on an exact tableau. A game
+ * that cannot be loaded is solved in mixed precision instead, and so is one
+ * that overflows, starting from the basis the exact tableau reached.
+ *
+ * workspace: buffers to solve in
+ * payoff: row-major payoff matrix, NULL if matrix is given
+ * dtype: type of the entries of payoff
+ * matrix: sparse payoff matrix, NULL if payoff is given
+ * m: number of rows
+ * n: number of columns
+ * options: options to solve with
+ * result: filled with the solution
+ *
+ * return: result->success
+ */
+bool solve_exact_in_workspace(Workspace_t* workspace, const void* payoff, Dtype_t dtype, SparseMatrix_t* matrix,
+                              int m, int n, const SolveOptions_t* options, SolveResult_t* result) {
+    double start = start_phase(workspace);
+    STATS_START(build_start);
+    reset_basis_tracking(workspace, m, n);
+
+    double* dense = NULL; // dense form built here, if any
+    if (payoff == NULL) {
+        payoff = dense = sparse_to_dense(matrix);
+        dtype = DTYPE_FLOAT64;
+    }
+
+    if (workspace->exact_tableau == NULL) workspace->exact_tableau = create_exact_tableau(m, n);
+    else reset_exact_tableau(workspace->exact_tableau, m, n);
+    ExactTableau_t* tableau = workspace->exact_tableau;
+
+    SolveOptions_t fallback = *options;
+    fallback.precision = PRECISION_MIXED;
+    if (!load_exact_tableau(tableau, payoff, dtype, m, n)) {
+        free(dense);
+        return solve_mixed_in_workspace(workspace, payoff, dtype, NULL, m, n, &fallback, result);
+    }
+
+    // move to the start basis, going back to the all slack basis if it is
+    // not feasible
+    int pivot_count = 0;
+    result->warm_started = false;
+    if (options->start != NULL) {
+        result->warm_started = warm_start_tableau(workspace, NULL, NULL, tableau, NULL, options->start);
+        if (!result->warm_started) {
+            reset_basis_tracking(workspace, m, n);
+            reset_exact_tableau(tableau, m, n);
+            load_exact_tableau(tableau, payoff, dtype, m, n);
+        }
+    }
+
+    Pricing_t* pricing = prepare_pricing(workspace, options->rule, n + m);
+    if (pricing != NULL) update_exact_tableau_pricing(pricing, tableau, -1, -1);
+    end_phase(workspace, &workspace->timings->build, start);
+    STATS_CYCLES(build_cycles, build_start);
+
+    pivot_count += run_simplex(workspace, NULL, NULL, tableau, NULL, NULL, NULL, pricing, n, options);
+    start = start_phase(workspace);
+    STATS_START(extract_start);
+    if (workspace->status != SOLVE_OPTIMAL) {
+        stop_at_limit(workspace, n, result);
+        result->pivots = pivot_count;
+        workspace->solved = false;
+    }
+    else if (tableau->overflow) {
+        // the basis reached is still a good start, its pivots were exact
+        SolveBasis_t basis = { 0, workspace->refine_rows, workspace->refine_cols };
+        export_basis(workspace, n, &basis);
+        fallback.start = &basis;
+        solve_mixed_in_workspace(workspace, payoff, dtype, NULL, m, n, &fallback, result);
+        result->pivots += pivot_count;
+    }
+    else {
+        read_exact_solution(workspace, tableau, m, n, result);
+        result->pivots = pivot_count;
+        workspace->solved = false;
+        workspace->m = m;
+        workspace->n = n;
+    }
+    end_phase(workspace, &workspace->timings->extract, start);
+    STATS_CYCLES(extract_cycles, extract_start);
+
+    free(dense);
+    return result->success;
+}
+
+/**
+ * Solves a game after presolving it, with no pivots when the kept game has
+ * a saddle point. The strategies and basis of the kept game are mapped back
+ * to the whole game, with 0 for the removed rows and columns. A game that
+ * presolve shrinks leaves the kept game in the tableau, so rows and columns
+ * cannot be appended to it.
+ *
+ * workspace: buffers to solve in
+ * payoff: m by n payoff matrix, row-major
+ * dtype: type of the entries of payoff
+ * m: number of rows
+ * n: number of columns
+ * options: options to solve with
+ * result: filled with the solution
+ *
+ * return: result->success
+ */
+bool solve_presolved_in_workspace(Workspace_t* workspace, const void* payoff, Dtype_t dtype, int m, int n,
+                                  const SolveOptions_t* options, SolveResult_t* result) {
+    if (workspace->presolve == NULL) workspace->presolve = (Presolve_t*) calloc(1, sizeof(Presolve_t));
+    Presolve_t* presolve = workspace->presolve;
+    double start = start_phase(workspace);
+    STATS_START(presolve_start);
+    presolve_game(presolve, payoff, dtype, m, n);
+    result->removed_rows = m - presolve->m;
+    result->removed_cols = n - presolve->n;
+
+    int saddle_row, saddle_col;
+    bool saddle = find_saddle_point(presolve, payoff, dtype, n, &saddle_row, &saddle_col);
+    end_phase(workspace, &workspace->timings->presolve, start);
+    STATS_CYCLES(presolve_cycles, presolve_start);
+    if (saddle) {
+        int row = presolve->rows[saddle_row];
+        int col = presolve->cols[saddle_col];
+        for (int index = 0; index < m; index++) result->p1_strategy[index] = (index == row);
+        for (int index = 0; index < n; index++) result->p2_strategy[index] = (index == col);
+        result->value = payoff_entry(payoff, dtype, (size_t) row * n + col);
+        result->pivots = 0;
+        result->warm_started = false;
+
+        // an integer value is exact without pivoting
+        result->exact = options->precision == PRECISION_EXACT && result->value == rint(result->value) &&
+                        fabs(result->value) < 0x1p63;
+        result->value_numerator = (result->exact)? (long long) result->value : 0;
+        result->value_denominator = (result->exact)? 1 : 0;
+
+        // the saddle point's column is basic in its row
+        if (result->basis.rows != NULL) {
+            result->basis.count = 1;
+            result->basis.rows[0] = row;
+            result->basis.cols[0] = col;
+        }
+        result->status = SOLVE_OPTIMAL;
+        result->success = true;
+        workspace->solved = false;
+        return true;
+    }
+    if (presolve->m == m && presolve->n == n) return solve_in_workspace(workspace, payoff, dtype, NULL, m, n, options, result);
+
+    // a start basis using a removed strategy cannot be mapped
+    SolveOptions_t kept_options = *options;
+    SolveBasis_t kept_start;
+    if (options->start != NULL)
+        kept_options.start = (presolve_basis(presolve, options->start, m, n, &kept_start))? &kept_start : NULL;
+
+    SolveResult_t kept = *result;
+    kept.p1_strategy = presolve->p1_strategy;
+    kept.p2_strategy = presolve->p2_strategy;
+    start = start_phase(workspace);
+    STATS_START(copy_start);
+    copy_kept_game(presolve, payoff, dtype, n);
+    end_phase(workspace, &workspace->timings->presolve, start);
+    STATS_CYCLES(presolve_cycles, copy_start);
+    solve_in_workspace(workspace, presolve->payoff, DTYPE_FLOAT64, NULL, presolve->m, presolve->n, &kept_options, &kept);
+    workspace->solved = false;
+
+    kept.p1_strategy = result->p1_strategy;
+    kept.p2_strategy = result->p2_strategy;
+    *result = kept;
+    if (result->status != SOLVE_INVALID && result->basis.rows != NULL) unpresolve_basis(presolve, &result->basis, n);
+    if (result->success) {
+        for (int row = 0; row < m; row++) result->p1_strategy[row] = 0;
+        for (int col = 0; col < n; col++) result->p2_strategy[col] = 0;
+        for (int row = 0; row < presolve->m; row++) result->p1_strategy[presolve->rows[row]] = presolve->p1_strategy[row];
+        for (int col = 0; col < presolve->n; col++) result->p2_strategy[presolve->cols[col]] = presolve->p2_strategy[col];
+    }
+    return result->success;
+}
+
+/**
+ * Re-optimizes the final tableau of a workspace after a row or column was
+ * appended to it, with the dual simplex method first when the tableau is
+ * no longer feasible
+ *
+ * workspace: buffers holding the tableau
+ * options: options to solve with
+ * result: filled with the solution
+ *
+ * return: result->success
+ */
+bool reoptimize_workspace(Workspace_t* workspace, const SolveOptions_t* options, SolveResult_t* result) {
+    Tableau_t* tableau = workspace->tableau;
+    int m = workspace->m;
+    int n = workspace->n;
+    double start = start_phase(workspace);
+    STATS_START(build_start);
+    PivotPool_t* pool = prepare_pool(workspace, options->threads);
+    apply_tolerances(options, tableau, NULL, NULL);
+
+    int pivot_count = 0;
+    result->warm_started = true;
+    if (!run_dual_simplex(workspace, tableau, pool, &pivot_count)) {
+        workspace->solved = false;
+        return false;
+    }
+
+    Pricing_t* pricing = prepare_pricing(workspace, options->rule, n + m);
+    if (pricing != NULL) update_tableau_pricing(pricing, tableau, -1, -1);
+    BlockedPivots_t* blocked = prepare_blocked_pivots(workspace, tableau, pool, options);
+    end_phase(workspace, &workspace->timings->build, start);
+    STATS_CYCLES(build_cycles, build_start);
+
+    pivot_count += run_simplex(workspace, tableau, NULL, NULL, NULL, pool, blocked, pricing, n, options);
+    start = start_phase(workspace);
+    STATS_START(extract_start);
+    if (workspace->status == SOLVE_OPTIMAL) read_solution(workspace, tableau, NULL, NULL, m, n, result);
+    else stop_at_limit(workspace, n, result);
+    end_phase(workspace, &workspace->timings->extract, start);
+    STATS_CYCLES(extract_cycles, extract_start);
+    result->pivots = pivot_count;
+    workspace->solved = result->success;
+    return result->success;
+}
+
+/**
+ * Struct for a solved game kept in a result cache, with its rows and columns
+ * in canonical order and shifted so its smallest payoff is 0
+ *
+ * hash: hash of the shape, precision and payoff
+ * m: number of rows
+ * n: number of columns
+ * precision: precision the game was solved in
+ * payoff: m by n canonical payoff matrix, row-major
+ * value: value of the canonical game
+ * p1_strategy: optimal strategy of the row player in canonical order
+ * p2_strategy: optimal strategy of the column player in canonical order
+ * basis_count: number of pivots reaching the final basis
+ * basis_rows: canonical row of each pivot
+ * basis_cols: canonical column entering at each pivot, n + i for the slack
+ *             of canonical row i
+ * bytes: memory the entry takes
+ * next: next entry in the same bucket
+ * newer: entry used after this one, NULL for the most recent
+ * older: entry used before this one, NULL for the least recent
+ */
+struct CacheEntry {
+    uint64_t hash;
+    int m;
+    int n;
+    Precision_t precision;
+    double* payoff;
+    double value;
+    double* p1_strategy;
+    double* p2_strategy;
+    int basis_count;
+    int* basis_rows;
+    int* basis_cols;
+    size_t bytes;
+    struct CacheEntry* next;
+    struct CacheEntry* newer;
+    struct CacheEntry* older;
+};
+typedef struct CacheEntry CacheEntry_t;
+
+/**
+ * Struct for a cache of solved games, looked up by their canonical form
+ *
+ * buckets: chains of entries by hash
+ * bucket_count: number of buckets, a power of two
+ * count: number of entries
+ * bytes: memory the entries take
+ * max_bytes: most memory the entries may take before the least recently
+ *            used are dropped
+ * newest: most recently used entry, NULL when empty
+ * oldest: least recently used entry, NULL when empty
+ * file: stream new entries are appended to, NULL to keep them in memory only
+ * lock: guards everything above but file, so threads can share the cache
+ * file_lock: guards file, so lookups never wait on a write to it
+ */
+struct ResultCache {
+    CacheEntry_t** buckets;
+    int bucket_count;
+    int count;
+    size_t bytes;
+    size_t max_bytes;
+    CacheEntry_t* newest;
+    CacheEntry_t* oldest;
+    FILE* file;
+    pthread_mutex_t lock;
+    pthread_mutex_t file_lock;
+};
+
+/**
+ * Struct for a game put in canonical form to look it up in a result cache
+ *
+ * hash: hash of the shape, precision and canonical payoff
+ * m: number of rows
+ * n: number of columns
+ * precision: precision the game is solved in
+ * shift: smallest payoff, subtracted from every payoff
+ * payoff: m by n canonical payoff matrix, row-major
+ * row_order: row of the game at each canonical row
+ * col_order: column of the game at each canonical column
+ */
+struct CanonicalGame {
+    uint64_t hash;
+    int m;
+    int n;
+    Precision_t precision;
+    double shift;
+    double* payoff;
+    int* row_order;
+    int* col_order;
+};
+typedef struct CanonicalGame CanonicalGame_t;
+
+/**
+ * Struct for sorting rows or columns by a signature
+ *
+ * hash: signature, the same for every row or column the canonical order
+ *       cannot tell apart
+ * index: row or column it belongs to
+ */
+struct Signature {
+    uint64_t hash;
+    int index;
+};
+typedef struct Signature Signature_t;
+
+/**
+ * Mixes a value into a hash with the splitmix64 finalizer
+ *
+ * hash: hash so far
+ * value: value to mix in
+ *
+ * return: new hash
+ */
+static inline uint64_t mix_hash(uint64_t hash, uint64_t value) {
+    hash ^= value + UINT64_C(0x9E3779B97F4A7C15) + (hash << 6) + (hash >> 2);
+    hash = (hash ^ (hash >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    hash = (hash ^ (hash >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return hash ^ (hash >> 31);
+}
+
+/**
+ * Gets the bits of a payoff, with negative zero read as zero so equal
+ * payoffs hash the same
+ *
+ * value: payoff to read
+ *
+ * return: bits of the payoff
+ */
+static inline uint64_t payoff_bits(double value) {
+    value += 0.0;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * Orders signatures by hash, then by index so the order is always the same
+ *
+ * a: first signature
+ * b: second signature
+ *
+ * return: negative, zero or positive as a comes before, with or after b
+ */
+int compare_signatures(const void* a, const void* b) {
+    const Signature_t* first = (const Signature_t*) a;
+    const Signature_t* second = (const Signature_t*) b;
+    if (first->hash != second->hash) return (first->hash < second->hash)? -1 : 1;
+    return first->index - second->index;
+}
+
+/**
+ * Refines the signatures of the rows or columns of a shifted payoff matrix
+ * by the signatures of the other side. Each new signature mixes the old one
+ * with a sum over its entries, which does not depend on their order.
+ *
+ * payoff: m by n shifted payoff matrix, row-major
+ * m: number of rows
+ * n: number of columns
+ * rows: refine the row signatures, otherwise the column signatures
+ * other: signatures of the other side, NULL for none yet
+ * signatures: signatures to refine, m for rows and n for columns
+ */
+void refine_signatures(const double* payoff, int m, int n, bool rows, const Signature_t* other, Signature_t* signatures) {
+    int count = (rows)? m : n;
+    int length = (rows)? n : m;
+    for (int index = 0; index < count; index++) {
+        uint64_t sum = 0;
+        for (int entry = 0; entry < length; entry++) {
+            size_t cell = (rows)? (size_t) index * n + entry : (size_t) entry * n + index;
+            uint64_t hash = mix_hash(0, payoff_bits(payoff[cell]));
+            sum += (other == NULL)? hash : mix_hash(hash, other[entry].hash);
+        }
+        signatures[index].hash = mix_hash(signatures[index].hash, sum);
+    }
+}
+
+/**
+ * Puts a game in canonical form: shifted so its smallest payoff is 0, which
+ * the tableau's shift absorbs anyway, with its rows and columns sorted by
+ * signatures that do not depend on their order. Games that are permutations
+ * and shifts of each other usually get the same form, unless their rows or
+ * columns are too alike to sort apart, and then they only miss the cache.
+ *
+ * canonical: struct to fill, free with free_canonical_game
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * m: number of rows
+ * n: number of columns
+ * precision: precision the game is solved in
+ *
+ * return: false if a payoff is not finite, leaving nothing to free
+ */
+bool canonicalize_game(CanonicalGame_t* canonical, const void* payoff, Dtype_t dtype, int m, int n, Precision_t precision) {
+    size_t size = (size_t) m * n;
+    double shift = DBL_MAX;
+    for (size_t index = 0; index < size; index++) {
+        double value = payoff_entry(payoff, dtype, index);
+        if (!isfinite(value)) return false;
+        shift = fmin(shift, value);
+    }
+
+    double* shifted = (double*) malloc(size * sizeof(double));
+    for (size_t index = 0; index < size; index++) shifted[index] = payoff_entry(payoff, dtype, index) - shift;
+
+    // two rounds of refinement tell apart rows whose payoffs are the same
+    // multiset but meet different columns
+    Signature_t* row_signatures = (Signature_t*) calloc(m, sizeof(Signature_t));
+    Signature_t* col_signatures = (Signature_t*) calloc(n, sizeof(Signature_t));
+    for (int row = 0; row < m; row++) row_signatures[row].index = row;
+    for (int col = 0; col < n; col++) col_signatures[col].index = col;
+    refine_signatures(shifted, m, n, true, NULL, row_signatures);
+    refine_signatures(shifted, m, n, false, NULL, col_signatures);
+    for (int round = 0; round < 2; round++) {
+        refine_signatures(shifted, m, n, true, col_signatures, row_signatures);
+        refine_signatures(shifted, m, n, false, row_signatures, col_signatures);
+    }
+    qsort(row_signatures, m, sizeof(Signature_t), compare_signatures);
+    qsort(col_signatures, n, sizeof(Signature_t), compare_signatures);
+
+    canonical->m = m;
+    canonical->n = n;
+    canonical->precision = precision;
+    canonical->shift = shift;
+    canonical->payoff = (double*) malloc(size * sizeof(double));
+    canonical->row_order = (int*) malloc(m * sizeof(int));
+    canonical->col_order = (int*) malloc(n * sizeof(int));
+    for (int row = 0; row < m; row++) canonical->row_order[row] = row_signatures[row].index;
+    for (int col = 0; col < n; col++) canonical->col_order[col] = col_signatures[col].index;
+
+    uint64_t hash = mix_hash(mix_hash(mix_hash(0, m), n), precision);
+    for (int row = 0; row < m; row++) {
+        const double* source = shifted + (size_t) canonical->row_order[row] * n;
+        double* target = canonical->payoff + (size_t) row * n;
+        for (int col = 0; col < n; col++) {
+            target[col] = source[canonical->col_order[col]] + 0.0;
+            hash = mix_hash(hash, payoff_bits(target[col]));
+        }
+    }
+    canonical->hash = hash;
+
+    free(shifted);
+    free(row_signatures);
+    free(col_signatures);
+    return true;
+}
+
+/**
+ * Frees the buffers of a canonical game
+ *
+ * canonical: struct whose buffers to free
+ */
+void free_canonical_game(CanonicalGame_t* canonical) {
+    free(canonical->payoff);
+    free(canonical->row_order);
+    free(canonical->col_order);
+}
+
+/**
+ * Frees a cache entry
+ *
+ * entry: struct to free
+ */
+void free_cache_entry(CacheEntry_t* entry) {
+    free(entry->payoff);
+    free(entry->p1_strategy);
+    free(entry->p2_strategy);
+    free(entry->basis_rows);
+    free(entry->basis_cols);
+    free(entry);
+}
+
+/**
+ * Creates a cache entry for a game, with its strategies and basis left for
+ * the caller to fill
+ *
+ * m: number of rows
+ * n: number of columns
+ * precision: precision the game was solved in
+ * basis_count: number of pivots reaching its final basis
+ *
+ * return: entry, free with free_cache_entry
+ */
+CacheEntry_t* create_cache_entry(int m, int n, Precision_t precision, int basis_count) {
+    size_t size = (size_t) m * n;
+    CacheEntry_t* entry = (CacheEntry_t*) calloc(1, sizeof(CacheEntry_t));
+    entry->m = m;
+    entry->n = n;
+    entry->precision = precision;
+    entry->payoff = (double*) malloc(size * sizeof(double));
+    entry->p1_strategy = (double*) malloc(m * sizeof(double));
+    entry->p2_strategy = (double*) malloc(n * sizeof(double));
+    entry->basis_count = basis_count;
+    entry->basis_rows = (int*) malloc((basis_count + 1) * sizeof(int));
+    entry->basis_cols = (int*) malloc((basis_count + 1) * sizeof(int));
+    entry->bytes = sizeof(CacheEntry_t) + (size + m + n) * sizeof(double) + 2 * (size_t) basis_count * sizeof(int);
+    return entry;
+}
+
+/**
+ * Finds the entry of a canonical game in a result cache
+ *
+ * cache: cache to search, which must be locked
+ * canonical: game to find
+ *
+ * return: entry of the game, NULL if it is not cached
+ */
+CacheEntry_t* find_cache_entry(ResultCache_t* cache, const CanonicalGame_t* canonical) {
+    CacheEntry_t* entry = cache->buckets[canonical->hash & (cache->bucket_count - 1)];
+    for (; entry != NULL; entry = entry->next) {
+        if (entry->hash == canonical->hash && entry->m == canonical->m && entry->n == canonical->n &&
+            entry->precision == canonical->precision &&
+            memcmp(entry->payoff, canonical->payoff, (size_t) entry->m * entry->n * sizeof(double)) == 0)
+            return entry;
+    }
+    return NULL;
+}
+
+/**
+ * Takes an entry out of the recency list of a result cache
+ *
+ * cache: cache holding the entry, which must be locked
+ * entry: entry to take out
+ */
+void unlink_cache_entry(ResultCache_t* cache, CacheEntry_t* entry) {
+    if (entry->newer != NULL) entry->newer->older = entry->older;
+    else cache->newest = entry->older;
+    if (entry->older != NULL) entry->older->newer = entry->newer;
+    else cache->oldest = entry->newer;
+    entry->newer = entry->older = NULL;
+}
+
+/**
+ * Puts an entry at the most recent end of the recency list of a result cache
+ *
+ * cache: cache holding the entry, which must be locked
+ * entry: entry to put there, which must not be in the list
+ */
+void link_cache_entry(ResultCache_t* cache, CacheEntry_t* entry) {
+    entry->older = cache->newest;
+    entry->newer = NULL;
+    if (cache->newest != NULL) cache->newest->newer = entry;
+    else cache->oldest = entry;
+    cache->newest = entry;
+}
+
+/**
+ * Drops an entry from a result cache and frees it
+ *
+ * cache: cache holding the entry, which must be locked
+ * entry: entry to drop
+ */
+void drop_cache_entry(ResultCache_t* cache, CacheEntry_t* entry) {
+    CacheEntry_t** link = &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+    while (*link != entry) link = &(*link)->next;
+    *link = entry->next;
+    unlink_cache_entry(cache, entry);
+    cache->count--;
+    cache->bytes -= entry->bytes;
+    free_cache_entry(entry);
+}
+
+/**
+ * Adds an entry to a result cache as the most recently used, dropping the
+ * least recently used ones until the entries fit in its memory. The buckets
+ * double whenever there are more entries than buckets.
+ *
+ * cache: cache to add to, which must be locked
+ * entry: entry to add, freed instead if it alone is too large
+ */
+void insert_cache_entry(ResultCache_t* cache, CacheEntry_t* entry) {
+    if (entry->bytes > cache->max_bytes) {
+        free_cache_entry(entry);
+        return;
+    }
+    while (cache->bytes + entry->bytes > cache->max_bytes) drop_cache_entry(cache, cache->oldest);
+
+    if (cache->count >= cache->bucket_count) {
+        int bucket_count = cache->bucket_count * 2;
+        CacheEntry_t** buckets = (CacheEntry_t**) calloc(bucket_count, sizeof(CacheEntry_t*));
+        for (int bucket = 0; bucket < cache->bucket_count; bucket++) {
+            CacheEntry_t* next;
+            for (CacheEntry_t* moved = cache->buckets[bucket]; moved != NULL; moved = next) {
+                next = moved->next;
+                moved->next = buckets[moved->hash & (bucket_count - 1)];
+                buckets[moved->hash & (bucket_count - 1)] = moved;
+            }
+        }
+        free(cache->buckets);
+        cache->buckets = buckets;
+        cache->bucket_count = bucket_count;
+    }
+
+    CacheEntry_t** bucket = &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+    entry->next = *bucket;
+    *bucket = entry;
+    link_cache_entry(cache, entry);
+    cache->count++;
+    cache->bytes += entry->bytes;
+}
+
+/**
+ * Formats an entry the way it is appended to a cache file: its shape,
+ * precision and basis count, then its value, payoff, strategies and basis,
+ * in native byte order
+ *
+ * entry: entry to format
+ * size: filled with the number of bytes in the record
+ *
+ * return: record, free with free
+ */
+char* format_cache_entry(const CacheEntry_t* entry, size_t* size) {
+    int header[4] = { entry->m, entry->n, (int) entry->precision, entry->basis_count };
+    size_t payoff_size = (size_t) entry->m * entry->n * sizeof(double);
+    size_t basis_size = entry->basis_count * sizeof(int);
+    *size = sizeof(header) + sizeof(double) + payoff_size + ((size_t) entry->m + entry->n) * sizeof(double) +
+            2 * basis_size;
+
+    char* record = (char*) malloc(*size);
+    char* cursor = record;
+    memcpy(cursor, header, sizeof(header));
+    cursor += sizeof(header);
+    memcpy(cursor, &entry->value, sizeof(double));
+    cursor += sizeof(double);
+    memcpy(cursor, entry->payoff, payoff_size);
+    cursor += payoff_size;
+    memcpy(cursor, entry->p1_strategy, entry->m * sizeof(double));
+    cursor += entry->m * sizeof(double);
+    memcpy(cursor, entry->p2_strategy, entry->n * sizeof(double));
+    cursor += entry->n * sizeof(double);
+    memcpy(cursor, entry->basis_rows, basis_size);
+    memcpy(cursor + basis_size, entry->basis_cols, basis_size);
+    return record;
+}
+
+/**
+ * Appends a record from format_cache_entry to the file of a cache. A failed
+ * write would leave a torn entry there, so the cache stops writing to the
+ * file after one.
+ *
+ * cache: cache whose file to append to
+ * record: record to append
+ * size: number of bytes in record
+ */
+void write_cache_record(ResultCache_t* cache, const char* record, size_t size) {
+    pthread_mutex_lock(&cache->file_lock);
+    if (cache->file != NULL && (fwrite(record, 1, size, cache->file) != size || fflush(cache->file) != 0)) {
+        fclose(cache->file);
+        cache->file = NULL;
+    }
+    pthread_mutex_unlock(&cache->file_lock);
+}
+
+/**
+ * Reads the next entry of a cache file, written by write_cache_record
+ *
+ * file: stream to read from
+ * remaining: bytes left in the file
+ *
+ * return: entry, NULL at the end of the file or at an entry cut short
+ */
+CacheEntry_t* read_cache_entry(FILE* file, long remaining) {
+    int header[4];
+    if (remaining < (long) sizeof(header) || fread(header, sizeof(int), 4, file) != 4) return NULL;
+    int m = header[0];
+    int n = header[1];
+    if (m < 1 || n < 1 || header[2] < PRECISION_DOUBLE || header[2] > PRECISION_EXACT || header[3] < 0 || header[3] > m)
+        return NULL;
+
+    // a torn entry must not allocate more than the file holds
+    size_t size = (size_t) m * n;
+    double bytes = sizeof(header) + (1.0 + size + m + n) * sizeof(double) + 2.0 * header[3] * sizeof(int);
+    if (bytes > remaining) return NULL;
+
+    CacheEntry_t* entry = create_cache_entry(m, n, (Precision_t) header[2], header[3]);
+    bool read = fread(&entry->value, sizeof(double), 1, file) == 1 &&
+                fread(entry->payoff, sizeof(double), size, file) == size &&
+                fread(entry->p1_strategy, sizeof(double), m, file) == (size_t) m &&
+                fread(entry->p2_strategy, sizeof(double), n, file) == (size_t) n &&
+                fread(entry->basis_rows, sizeof(int), entry->basis_count, file) == (size_t) entry->basis_count &&
+                fread(entry->basis_cols, sizeof(int), entry->basis_count, file) == (size_t) entry->basis_count;
+    if (!read) {
+        free_cache_entry(entry);
+        return NULL;
+    }
+
+    uint64_t hash = mix_hash(mix_hash(mix_hash(0, m), n), entry->precision);
+    for (size_t index = 0; index < size; index++) hash = mix_hash(hash, payoff_bits(entry->payoff[index]));
+    entry->hash = hash;
+    return entry;
+}
+
+/**
+ * Opens a cache file and checks it starts with CACHE_MAGIC, writing it to a
+ * new file
+ *
+ * path: path of the file
+ *
+ * return: stream positioned after the magic, NULL if the file cannot be
+ *         opened or is not a cache file
+ */
+FILE* open_cache_file(const char* path) {
+    FILE* file = fopen(path, "a+b");
+    if (file == NULL) return NULL;
+
+    char magic[sizeof(CACHE_MAGIC) - 1];
+    bool valid = true;
+    rewind(file);
+    size_t length = fread(magic, 1, sizeof(magic), file);
+    if (length == 0) {
+        fseek(file, 0, SEEK_END);
+        valid = fwrite(CACHE_MAGIC, 1, sizeof(magic), file) == sizeof(magic) && fflush(file) == 0;
+    }
+    else valid = length == sizeof(magic) && memcmp(magic, CACHE_MAGIC, sizeof(magic)) == 0;
+
+    if (!valid) {
+        fclose(file);
+        return NULL;
+    }
+    return file;
+}
+
+/**
+ * Answers a game from a result cache, permuting the cached strategies and
+ * basis back to the game's order and shifting the value back
+ *
+ * cache: cache to look in
+ * canonical: canonical form of the game
+ * result: filled with the solution if the game is cached
+ *
+ * return: true if the game was cached
+ */
+bool lookup_result_cache(ResultCache_t* cache, const CanonicalGame_t* canonical, SolveResult_t* result) {
+    pthread_mutex_lock(&cache->lock);
+    CacheEntry_t* entry = find_cache_entry(cache, canonical);
+    if (entry != NULL) {
+        unlink_cache_entry(cache, entry);
+        link_cache_entry(cache, entry);
+
+        int n = canonical->n;
+        for (int row = 0; row < canonical->m; row++) result->p1_strategy[canonical->row_order[row]] = entry->p1_strategy[row];
+        for (int col = 0; col < n; col++) result->p2_strategy[canonical->col_order[col]] = entry->p2_strategy[col];
+        result->value = entry->value + canonical->shift;
+        if (result->basis.rows != NULL) {
+            result->basis.count = entry->basis_count;
+            for (int pivot = 0; pivot < entry->basis_count; pivot++) {
+                int col = entry->basis_cols[pivot];
+                result->basis.rows[pivot] = canonical->row_order[entry->basis_rows[pivot]];
+                result->basis.cols[pivot] = (col < n)? canonical->col_order[col] : n + canonical->row_order[col - n];
+            }
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return entry != NULL;
+}
+
+/**
+ * Adds a solved game to a result cache, in canonical order, and appends it
+ * to the cache's file if it has one
+ *
+ * cache: cache to add to
+ * canonical: canonical form of the game
+ * result: solution of the game, with its basis filled
+ */
+void store_result_cache(ResultCache_t* cache, const CanonicalGame_t* canonical, const SolveResult_t* result) {
+    int m = canonical->m;
+    int n = canonical->n;
+    CacheEntry_t* entry = create_cache_entry(m, n, canonical->precision, result->basis.count);
+    entry->hash = canonical->hash;
+    memcpy(entry->payoff, canonical->payoff, (size_t) m * n * sizeof(double));
+    entry->value = result->value - canonical->shift;
+    for (int row = 0; row < m; row++) entry->p1_strategy[row] = result->p1_strategy[canonical->row_order[row]];
+    for (int col = 0; col < n; col++) entry->p2_strategy[col] = result->p2_strategy[canonical->col_order[col]];
+
+    // the basis is stored by canonical position, the inverse of the orders
+    int* row_position = (int*) malloc(m * sizeof(int));
+    int* col_position = (int*) malloc(n * sizeof(int));
+    for (int row = 0; row < m; row++) row_position[canonical->row_order[row]] = row;
+    for (int col = 0; col < n; col++) col_position[canonical->col_order[col]] = col;
+    for (int pivot = 0; pivot < entry->basis_count; pivot++) {
+        int col = result->basis.cols[pivot];
+        entry->basis_rows[pivot] = row_position[result->basis.rows[pivot]];
+        entry->basis_cols[pivot] = (col < n)? col_position[col] : n + row_position[col - n];
+    }
+    free(row_position);
+    free(col_position);
+
+    // the record is formatted while the entry is still private, since once
+    // inserted it can be dropped by another thread
+    pthread_mutex_lock(&cache->file_lock);
+    bool persistent = cache->file != NULL;
+    pthread_mutex_unlock(&cache->file_lock);
+    size_t size = 0;
+    char* record = (persistent)? format_cache_entry(entry, &size) : NULL;
+
+    // another thread may have solved the same game meanwhile
+    pthread_mutex_lock(&cache->lock);
+    bool added = find_cache_entry(cache, canonical) == NULL;
+    if (added) insert_cache_entry(cache, entry);
+    else free_cache_entry(entry);
+    pthread_mutex_unlock(&cache->lock);
+
+    if (added && record != NULL) write_cache_record(cache, record, size);
+    free(record);
+}
+
+/**
+ * Solves a dense game through the result cache of its options. A cached
+ * game is answered without pivoting and leaves nothing in the workspace to
+ * append to, and a solved one is added to the cache.
+ *
+ * workspace: buffers to solve in
+ * payoff: row-major payoff matrix
+ * dtype: type of the entries of payoff
+ * m: number of rows
+ * n: number of columns
+ * options: options to solve with, whose cache is set
+ * result: filled with the solution
+ *
+ * return: result->success
+ */
+bool solve_cached_in_workspace(Workspace_t* workspace, const void* payoff, Dtype_t dtype, int m, int n,
+                               const SolveOptions_t* options, SolveResult_t* result) {
+    CanonicalGame_t canonical;
+    if (!canonicalize_game(&canonical, payoff, dtype, m, n, options->precision)) {
+        return (options->presolve)? solve_presolved_in_workspace(workspace, payoff, dtype, m, n, options, result)
+                                  : solve_in_workspace(workspace, payoff, dtype, NULL, m, n, options, result);
+    }
+
+    if (lookup_result_cache(options->cache, &canonical, result)) {
+        result->pivots = 0;
+        result->warm_started = false;
+        result->exact = false;
+        result->value_numerator = 0;
+        result->value_denominator = 0;
+        result->cached = true;
+        result->status = SOLVE_OPTIMAL;
+        result->success = true;
+        workspace->solved = false;
+        free_canonical_game(&canonical);
+        return true;
+    }
+
+    // the cache keeps the final basis even when the caller does not want it
+    SolveBasis_t basis = result->basis;
+    if (basis.rows == NULL) {
+        result->basis.rows = (int*) malloc(m * sizeof(int));
+        result->basis.cols = (int*) malloc(m * sizeof(int));
+    }
+    bool success = (options->presolve)? solve_presolved_in_workspace(workspace, payoff, dtype, m, n, options, result)
+                                      : solve_in_workspace(workspace, payoff, dtype, NULL, m, n, options, result);
+    if (success) store_result_cache(options->cache, &canonical, result);
+    if (basis.rows == NULL) {
+        free(result->basis.rows);
+        free(result->basis.cols);
+        result->basis.rows = NULL;
+        result->basis.cols = NULL;
+    }
+    free_canonical_game(&canonical);
+    return success;
+}
+
+ResultCache_t* create_result_cache(size_t max_bytes, const char* path) {
+    FILE* file = NULL;
+    if (path != NULL && (file = open_cache_file(path)) == NULL) return NULL;
+
+    ResultCache_t* cache = (ResultCache_t*) calloc(1, sizeof(ResultCache_t));
+    cache->bucket_count = CACHE_BUCKETS;
+    cache->buckets = (CacheEntry_t**) calloc(cache->bucket_count, sizeof(CacheEntry_t*));
+    cache->max_bytes = max_bytes;
+    cache->file = file;
+    pthread_mutex_init(&cache->lock, NULL);
+    pthread_mutex_init(&cache->file_lock, NULL);
+    if (file == NULL) return cache;
+
+    // later entries are the more recent, so they outlast earlier ones
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, sizeof(CACHE_MAGIC) - 1, SEEK_SET);
+    long end = ftell(file);
+    CacheEntry_t* entry;
+    while ((entry = read_cache_entry(file, size - end)) != NULL) {
+        CanonicalGame_t key = { entry->hash, entry->m, entry->n, entry->precision, 0, entry->payoff, NULL, NULL };
+        if (find_cache_entry(cache, &key) == NULL) insert_cache_entry(cache, entry);
+        else free_cache_entry(entry);
+        end = ftell(file);
+    }
+
+    // an entry cut short by a crash is dropped, so new ones follow the last
+    // whole one. a file that cannot be cut leaves the cache in memory only
+    if (end < size && ftruncate(fileno(file), end) != 0) {
+        fclose(file);
+        cache->file = NULL;
+    }
+    else fseek(file, 0, SEEK_END);
+    return cache;
+}
+
+void free_result_cache(ResultCache_t* cache) {
+    while (cache->oldest != NULL) drop_cache_entry(cache, cache->oldest);
+    if (cache->file != NULL) fclose(cache->file);
+    pthread_mutex_destroy(&cache->lock);
+    pthread_mutex_destroy(&cache->file_lock);
+    free(cache->buckets);
+    free(cache);
+}
+
+bool solve_game(const double* payoff, int m, int n, const SolveOptions_t* options, SolveResult_t* result) {
+    Workspace_t* workspace = create_workspace();
+    bool success = solve_dense_game(workspace, payoff, DTYPE_FLOAT64, m, n, options, result);
+    free_workspace(workspace);
+    return success;
+}
+
+bool solve_dense_game(Workspace_t* workspace, const void* payoff, Dtype_t dtype, int m, int n,
+                      const SolveOptions_t* options, SolveResult_t* result) {
+    SolveOptions_t defaults;
+    if (options == NULL) {
+        default_solve_options(&defaults);
+        options = &defaults;
+    }
+
+    result->success = false;
+    result->status = SOLVE_INVALID;
+    result->removed_rows = 0;
+    result->removed_cols = 0;
+    result->out_of_core = false;
+    result->cached = false;
+    if (payoff == NULL || m < 1 || n < 1) return false;
+    start_solve(workspace, options);
+    bool success;
+    if (options->cache != NULL && options->precision != PRECISION_EXACT)
+        success = solve_cached_in_workspace(workspace, payoff, dtype, m, n, options, result);
+    else if (options->presolve) success = solve_presolved_in_workspace(workspace, payoff, dtype, m, n, options, result);
+    else success = solve_in_workspace(workspace, payoff, dtype, NULL, m, n, options, result);
+    finish_solve(workspace);
+    return success;
+}
+
+bool solve_sparse_game(Workspace_t* workspace, int m, int n, size_t count, const int* rows,
+                       const int* cols, const double* values, const SolveOptions_t* options,
+                       SolveResult_t* result) {
+    SolveOptions_t defaults;
+    if (options == NULL) {
+        default_solve_options(&defaults);
+        options = &defaults;
+    }
+
+    result->success = false;
+    result->status = SOLVE_INVALID;
+    result->removed_rows = 0;
+    result->removed_cols = 0;
+    result->out_of_core = false;
+    result->cached = false;
+    if (m < 1 || n < 1) return false;
+    for (size_t entry = 0; entry < count; entry++) {
+        if (rows[entry] < 0 || rows[entry] >= m || cols[entry] < 0 || cols[entry] >= n) return false;
+    }
+
+    start_solve(workspace, options);
+    SparseMatrix_t* matrix = create_sparse_matrix(m, n, count, rows, cols, values);
+    bool success;
+    if (options->presolve && options->engine == ENGINE_TABLEAU) {
+        // the tableau densifies the game anyway
+        double* dense = sparse_to_dense(matrix);
+        success = solve_presolved_in_workspace(workspace, dense, DTYPE_FLOAT64, m, n, options, result);
+        free(dense);
+    }
+    else success = solve_in_workspace(workspace, NULL, DTYPE_FLOAT64, matrix, m, n, options, result);
+    free_sparse_matrix(matrix);
+    finish_solve(workspace);
+    return success;
+}
+
+bool append_game_column(Workspace_t* workspace, const double* column, const SolveOptions_t* options,
+                        SolveResult_t* result) {
+    SolveOptions_t defaults;
+    if (options == NULL) {
+        default_solve_options(&defaults);
+        options = &defaults;
+    }
+
+    result->success = false;
+    result->status = SOLVE_INVALID;
+    result->removed_rows = 0;
+    result->removed_cols = 0;
+    result->out_of_core = false;
+    result->cached = false;
+    if (!workspace->solved || column == NULL) return false;
+    start_solve(workspace, options);
+
+    Tableau_t* tableau = workspace->tableau;
+    int m = workspace->m;
+    int n = workspace->n;
+
+    // keep every shifted entry at least 1, like the initial tableau
+    double k = tableau->k;
+    for (int row = 0; row < m; row++) k = fmax(k, 1 - column[row]);
+    if (k > tableau->k) shift_tableau(tableau, k);
+
+    // the slack columns move one to the right of the new column
+    for (int row = 0; row < m; row++) {
+        if (workspace->basis[row] >= n) workspace->basis[row]++;
+    }
+
+    append_tableau_column(tableau, column);
+    workspace->n = n + 1;
+    bool success = reoptimize_workspace(workspace, options, result);
+    finish_solve(workspace);
+    return success;
+}
+
+bool append_game_row(Workspace_t* workspace, const double* payoff_row, const SolveOptions_t* options,
+                     SolveResult_t* result) {
+    SolveOptions_t defaults;
+    if (options == NULL) {
+        default_solve_options(&defaults);
+        options = &defaults;
+    }
+
+    result->success = false;
+    result->status = SOLVE_INVALID;
+    result->removed_rows = 0;
+    result->removed_cols = 0;
+    result->out_of_core = false;
+    result->cached = false;
+    if (!workspace->solved || payoff_row == NULL) return false;
+    start_solve(workspace, options);
+
+    Tableau_t* tableau = workspace->tableau;
+    int m = workspace->m;
+    int n = workspace->n;
+
+    // keep every shifted entry at least 1, like the initial tableau
+    double k = tableau->k;
+    for (int col = 0; col < n; col++) k = fmax(k, 1 - payoff_row[col]);
+    if (k > tableau->k) shift_tableau(tableau, k);
+
+    // the new slack is basic in the new row
+    reserve_basis_tracking(workspace, m + 1);
+    append_tableau_row(tableau, workspace->basis, payoff_row);
+    workspace->basis[m] = n + m;
+
+    workspace->m = m + 1;
+    bool success = reoptimize_workspace(workspace, options, result);
+    finish_solve(workspace);
+    return success;
+}
@@ -0,0 +1,111 @@
+/**
+ * Author: Aidan Lynch
+ *
+ * parse: parses the numbers and indices of payoff matrices in text form
+ */
+
+#include "parse.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+
+bool parse_number(const char** cursor, const char* end, double* value) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char* start = *cursor;
+    const char* position = start;
+    bool negative = false;
+    if (position < end && (*position == '-' || *position == '+')) negative = (*position++ == '-');
+
+    uint64_t mantissa = 0;
+    int digits = 0; // significant digits in mantissa
+    int exponent = 0;
+    bool any_digit = false;
+    bool exact = true;
+
+    for (; position < end && *position >= '0' && *position <= '9'; position++) {
+        any_digit = true;
+        if (digits < 19) {
+            mantissa = 10 * mantissa + (uint64_t) (*position - '0');
+            if (mantissa > 0) digits++;
+        }
+        else {
+            exponent++;
+            exact = false;
+        }
+    }
+    if (position < end && *position == '.') {
+        for (position++; position < end && *position >= '0' && *position <= '9'; position++) {
+            any_digit = true;
+            if (digits < 19) {
+                mantissa = 10 * mantissa + (uint64_t) (*position - '0');
+                if (mantissa > 0) digits++;
+                exponent--;
+            }
+            else exact = false;
+        }
+    }
+    if (!any_digit) return false;
+
+    if (position < end && (*position == 'e' || *position == 'E')) {
+        const char* mark = position++;
+        bool exponent_negative = false;
+        if (position < end && (*position == '-' || *position == '+')) exponent_negative = (*position++ == '-');
+        if (position == end || *position < '0' || *position > '9') {
+            position = mark; // not an exponent after all
+        }
+        else {
+            int written = 0;
+            for (; position < end && *position >= '0' && *position <= '9'; position++)
+                if (written < 100000) written = 10 * written + (*position - '0');
+            exponent += exponent_negative? -written : written;
+        }
+    }
+    if (position < end && *position != ' ' && *position != '\t' && *position != '\r' && *position != '\n')
+        return false;
+
+    if (exact && mantissa <= (UINT64_C(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double number = (double) mantissa;
+        number = (exponent < 0)? number / powers[-exponent] : number * powers[exponent];
+        *value = negative? -number : number;
+    }
+    else {
+        // copy out the token since the input is not null terminated
+        size_t length = (size_t) (position - start);
+        char* token = (char*) malloc(length + 1);
+        memcpy(token, start, length);
+        token[length] = '\0';
+        *value = strtod(token, NULL);
+        free(token);
+    }
+
+    *cursor = position;
+    return true;
+}
+
+bool parse_index(const char** cursor, const char* end, int* index) {
+    const char* position = *cursor;
+    long long number = 0;
+    for (; position < end && *position >= '0' && *position <= '9'; position++) {
+        number = 10 * number + (*position - '0');
+        if (number > INT_MAX) return false;
+    }
+    if (position == *cursor || (position < end && *position != ' ' && *position != '\t')) return false;
+
+    *index = (int) number;
+    *cursor = position;
+    return true;
+}
+
+bool parse_row(const char* start, const char* end, double* row, int n) {
+    const char* cursor = start;
+    for (int col = 0; col < n; col++) {
+        cursor = skip_blanks(cursor, end);
+        if (!parse_number(&cursor, end, &row[col])) return false;
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+/**
+ * Author: Aidan Lynch
+ *
+ * parse: parses the numbers and indices of payoff matrices in text form
+ */
+
+#ifndef PARSE_H
+#define PARSE_H
+
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * Skips spaces and tabs, but not line breaks
+ *
+ * cursor: position to start from
+ * end: end of the text
+ *
+ * return: first position that is not a space or tab
+ */
+static inline const char* skip_blanks(const char* cursor, const char* end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) cursor++;
+    return cursor;
+}
+
+/**
+ * Finds the end of a line
+ *
+ * cursor: position in the line
+ * end: end of the text
+ *
+ * return: position of the line break, or end for the last line
+ */
+static inline const char* find_line_end(const char* cursor, const char* end) {
+    const char* line_end = (const char*) memchr(cursor, '\n', (size_t) (end - cursor));
+    return (line_end == NULL)? end : line_end;
+}
+
+/**
+ * Parses a decimal number with optional sign, fraction and exponent. Numbers
+ * with at most 19 significant digits and a small exponent are converted
+ * exactly with one multiplication or division, the rest go through strtod.
+ *
+ * cursor: position of the number, moved past it on success
+ * end: end of the text
+ * value: set to the parsed number on success
+ *
+ * return: if a number ending at a blank, line break or the end was parsed
+ */
+bool parse_number(const char** cursor, const char* end, double* value);
+
+/**
+ * Parses a row index or column index
+ *
+ * cursor: position of the index, moved past it on success
+ * end: end of the text
+ * index: set to the parsed index on success
+ *
+ * return: if a nonnegative integer ending at a blank was parsed
+ */
+bool parse_index(const char** cursor, const char* end, int* index);
+
+/**
+ * Parses one line of a dense payoff matrix. Anything after the first n
+ * numbers is ignored.
+ *
+ * start: beginning of the line
+ * end: end of the line, excluding the line break
+ * row: filled with n numbers
+ * n: number of columns
+ *
+ * return: if the line held at least n numbers
+ */
+bool parse_row(const char* start, const char* end, double* row, int n);
+
+#endif
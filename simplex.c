@@ -5,51 +5,241 @@
  * strategies and the value of the game
  */
 
+#include "simplex.h"
+#include "parse.h"
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
-#include <float.h>
+#include <limits.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <signal.h>
+#include <poll.h>
 
-/**
- * Frees a 2 dimensional array.
- *
- * rows: number of rows
- */
-void free_2d_arr(void** arr, int rows) {
-    if (arr != NULL) {
-        // free row arrays
-        for (int row = 0; row < rows; row++) {
-            if (arr[row] != NULL) free(arr[row]);
-        }
+// input that cannot be mapped is read in blocks of at least this many bytes
+#define INPUT_BLOCK_SIZE (1 << 20)
 
-        free(arr);
-    }
-}
+// binary payoff files start with this magic and version, see BinaryHeader
+#define BINARY_MAGIC "SPXB"
+#define BINARY_VERSION 1
+#define BINARY_SPARSE 1
+// and results sent by a server start with this magic, see BinaryResult
+#define RESULT_MAGIC "SPXR"
+
+// binary payoffs and results are little endian and are read and written in
+// place, payoffs straight from the mapped file, so only little endian hosts
+// are supported
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "simplex reads and writes the little endian binary formats in place"
+#endif
+
+// batches are solved this many games at a time, and games whose tableau has
+// at least this many entries are pivoted by the whole pool
+#define BATCH_WINDOW 4096
+#define BATCH_LARGE_TABLEAU (1 << 18)
+
+// the result cache keeps at most this many bytes of games in memory
+#define CACHE_BYTES ((size_t) 1 << 30)
+
+// connections waiting for a free server worker queue up to this many deep
+#define SERVER_BACKLOG 64
+// a server rejects requests with more strategies for a player, or a larger
+// body, than these, so no client can make it allocate without bound
+#define SERVER_MAX_STRATEGIES (1 << 20)
+#define SERVER_MAX_BODY_BYTES ((size_t) 1 << 30)
+// a connection that neither sends nor takes bytes for this long is closed,
+// so idle clients cannot hold every worker
+#define SERVER_IDLE_MS 30000
+
+
+// stdout is fully buffered with a buffer of this many bytes
+#define STDOUT_BUFFER_SIZE (1 << 16)
+
+// exit statuses of solves stopped at a limit, in a batch the first one's
+#define EXIT_PIVOT_LIMIT 2
+#define EXIT_TIME_LIMIT 3
 
 /**
  * Print the usage statement for this program.
  */
 void print_usage() {
-    printf("usage: simplex m n\n");
+    printf("usage: simplex [options] m n\n");
+    printf("       simplex [options] --binary < file\n");
+    printf("       simplex [options] --batch < games\n");
+    printf("       simplex [options] --serve PATH\n");
     printf("\tm: number of rows, integer greater than 0\n");
     printf("\tn: number of columns, integer greater than 0\n");
+    printf("options:\n");
+    printf("\t--threads N: pivot with N threads, default 1, or solve a batch with N threads\n");
+    printf("\t--block-pivots K: defer K tableau pivots and apply them together, default 0 for none\n");
+    printf("\t--tableau-dir DIR: keep the tableau in a file in DIR, for games too large for memory\n");
+    printf("\t--engine E: tableau or revised simplex, default tableau unless --sparse\n");
+    printf("\t--sparse: enter the payoff matrix as row, column, value triples\n");
+    printf("\t--binary: read the size and payoff matrix from a binary file\n");
+    printf("\t--batch: solve games each given as m and n then the payoff matrix, one record per game\n");
+    printf("\t--serve PATH: answer binary games on the Unix socket PATH, serving --threads connections at once\n");
+    printf("\t--pivot-rule R: dantzig (default), steepest, devex, partial, multiple or bland\n");
+    printf("\t--precision P: tableau precision, double (default), float, mixed or exact\n");
+    printf("\t--pivot-tolerance T: smallest pivot column entry that can pivot, default for the precision\n");
+    printf("\t--feasibility-tolerance T: how far below zero a basic variable may go, default for the precision\n");
+    printf("\t--max-pivots N: stop after N pivots, exiting with status 2 if not optimal\n");
+    printf("\t--time-limit S: stop after S seconds, exiting with status 3 if not optimal\n");
+    printf("\t--presolve: remove dominated strategies first and solve saddle points without pivoting\n");
+    printf("\t--cache FILE: answer games solved before from the result cache in FILE, adding new ones to it\n");
+    printf("\t--stats: print the hot path counters of the solve to stderr as JSON\n");
+    printf("\t--quiet: print only the strategies, value and pivot count\n");
+    printf("\t--trace-every K: print every Kth tableau and the final one, default 1\n");
+    printf("\t--start-basis FILE: start from the basis saved in FILE when it is feasible\n");
+    printf("\t--save-basis FILE: save the final basis to FILE as row and column pivots\n");
 }
 
+
 /**
  * Struct for storing the result of parsing command line arguments
  *
  * success: parsing of command line arguments was successful
  * m: number of rows
  * n: number of columns
+ * threads: number of threads to pivot with
+ * block_pivots: number of pivots to defer and apply together, 0 for none
+ * tableau_dir: directory to keep the tableau in a file in, NULL for memory
+ * engine: simplex implementation to solve with
+ * sparse: payoff matrix is entered in sparse form
+ * binary: payoff matrix and its size are read in binary form
+ * batch: a stream of games is read, each starting with its size
+ * serve: path of the Unix socket to serve games on, NULL to solve one game
+ *        or a batch
+ * rule: rule for choosing the entering column
+ * precision: element type the tableau engine pivots in
+ * pivot_tolerance: smallest pivot column entry that can pivot, 0 for the
+ *                  default
+ * feasibility_tolerance: how far below zero a basic variable may go, 0 for
+ *                        the default
+ * max_pivots: most pivots per game, 0 for no limit
+ * time_limit: most seconds per game, 0 for no limit
+ * presolve: remove dominated rows and columns before solving
+ * cache: file of the result cache, NULL for none
+ * stats: print the hot path counters of the solve
+ * trace_every: print every this many tableaus and pivots, 0 prints neither
+ *              nor the input prompt
+ * start_basis: file to read the start basis from, NULL for none
+ * save_basis: file to write the final basis to, NULL for none
  */
 struct ArgResult {
     bool success;
     int m;
     int n;
+    int threads;
+    int block_pivots;
+    const char* tableau_dir;
+    Engine_t engine;
+    bool sparse;
+    bool binary;
+    bool batch;
+    const char* serve;
+    PivotRule_t rule;
+    Precision_t precision;
+    double pivot_tolerance;
+    double feasibility_tolerance;
+    int max_pivots;
+    double time_limit;
+    bool presolve;
+    const char* cache;
+    bool stats;
+    int trace_every;
+    const char* start_basis;
+    const char* save_basis;
 };
 typedef struct ArgResult ArgResult_t;
 
+/**
+ * Fills the options games are solved with from the command line arguments.
+ * Traces go to stdout.
+ *
+ * args: parsed command line arguments
+ * cache: result cache opened from args, NULL for none
+ * options: struct to fill
+ */
+void get_solve_options(const ArgResult_t* args, ResultCache_t* cache, SolveOptions_t* options) {
+    default_solve_options(options);
+    options->engine = args->engine;
+    options->rule = args->rule;
+    options->precision = args->precision;
+    options->pivot_tolerance = args->pivot_tolerance;
+    options->feasibility_tolerance = args->feasibility_tolerance;
+    options->max_pivots = args->max_pivots;
+    options->time_limit = args->time_limit;
+    options->presolve = args->presolve;
+    options->cache = cache;
+    options->threads = args->threads;
+    options->block_pivots = args->block_pivots;
+    options->tableau_dir = args->tableau_dir;
+    options->trace_every = args->trace_every;
+    options->trace = stdout;
+}
+
+/**
+ * Parses a whole string as an integer.
+ *
+ * string: string to parse
+ * min: smallest accepted value
+ * value: set to the parsed integer on success
+ *
+ * return: if the string was a valid integer of at least min
+ */
+bool parse_int(const char* string, long min, int* value) {
+    char* check = NULL;
+    long number = strtol(string, &check, 10);
+
+    if (check == string || *check != '\0' || number < min || number > INT_MAX) return false;
+    *value = (int) number;
+    return true;
+}
+
+/**
+ * Parses a whole string as a tolerance.
+ *
+ * string: string to parse
+ * value: set to the parsed number on success
+ *
+ * return: if the string was a valid number between 0 and 1
+ */
+bool parse_tolerance(const char* string, double* value) {
+    char* check = NULL;
+    double number = strtod(string, &check);
+
+    if (check == string || *check != '\0' || !(number > 0 && number < 1)) return false;
+    *value = number;
+    return true;
+}
+
+/**
+ * Parses a whole string as a number of seconds.
+ *
+ * string: string to parse
+ * value: set to the parsed number on success
+ *
+ * return: if the string was a valid positive number
+ */
+bool parse_seconds(const char* string, double* value) {
+    char* check = NULL;
+    double number = strtod(string, &check);
+
+    if (check == string || *check != '\0' || !(number > 0 && number <= INT_MAX)) return false;
+    *value = number;
+    return true;
+}
+
 /**
  * Parses this program's command line arguments.
  *
@@ -60,11 +250,155 @@ typedef struct ArgResult ArgResult_t;
  */
 ArgResult_t* parse_args(int argc, char** argv) {
     ArgResult_t* result = (ArgResult_t*) malloc(sizeof(ArgResult_t));
+    result->success = false;
+    result->m = -1;
+    result->n = -1;
+    result->threads = 1;
+    result->block_pivots = 0;
+    result->tableau_dir = NULL;
+    result->engine = ENGINE_TABLEAU;
+    result->sparse = false;
+    result->binary = false;
+    result->batch = false;
+    result->serve = NULL;
+    result->rule = RULE_DANTZIG;
+    result->precision = PRECISION_DOUBLE;
+    result->pivot_tolerance = 0;
+    result->feasibility_tolerance = 0;
+    result->max_pivots = 0;
+    result->time_limit = 0;
+    result->presolve = false;
+    result->cache = NULL;
+    result->stats = false;
+    result->trace_every = 1;
+    result->start_basis = NULL;
+    result->save_basis = NULL;
+    bool engine_set = false;
 
-    if (argc != 3) { // invalid number of arguments
-        result->success = false;
-        result->m = -1;
-        result->n = -1;
+    static struct option long_options[] = {
+        { "threads", required_argument, NULL, 't' },
+        { "block-pivots", required_argument, NULL, 'L' },
+        { "tableau-dir", required_argument, NULL, 'O' },
+        { "engine", required_argument, NULL, 'e' },
+        { "sparse", no_argument, NULL, 's' },
+        { "binary", no_argument, NULL, 'b' },
+        { "batch", no_argument, NULL, 'B' },
+        { "serve", required_argument, NULL, 'Z' },
+        { "pivot-rule", required_argument, NULL, 'r' },
+        { "precision", required_argument, NULL, 'p' },
+        { "pivot-tolerance", required_argument, NULL, 'P' },
+        { "feasibility-tolerance", required_argument, NULL, 'F' },
+        { "max-pivots", required_argument, NULL, 'M' },
+        { "time-limit", required_argument, NULL, 'T' },
+        { "presolve", no_argument, NULL, 'D' },
+        { "cache", required_argument, NULL, 'C' },
+        { "stats", no_argument, NULL, 'X' },
+        { "quiet", no_argument, NULL, 'q' },
+        { "trace-every", required_argument, NULL, 'k' },
+        { "start-basis", required_argument, NULL, 'S' },
+        { "save-basis", required_argument, NULL, 'W' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    // parse options
+    int option;
+    while ((option = getopt_long(argc, argv, "", long_options, NULL)) != -1) {
+        switch (option) {
+            case 't':
+                if (!parse_int(optarg, 1, &result->threads)) return result;
+                break;
+            case 'L':
+                if (!parse_int(optarg, 0, &result->block_pivots)) return result;
+                break;
+            case 'O':
+                result->tableau_dir = optarg;
+                break;
+            case 'e':
+                if (strcmp(optarg, "tableau") == 0) result->engine = ENGINE_TABLEAU;
+                else if (strcmp(optarg, "revised") == 0) result->engine = ENGINE_REVISED;
+                else return result;
+                engine_set = true;
+                break;
+            case 's':
+                result->sparse = true;
+                break;
+            case 'b':
+                result->binary = true;
+                break;
+            case 'B':
+                result->batch = true;
+                break;
+            case 'Z':
+                result->serve = optarg;
+                break;
+            case 'r':
+                if (strcmp(optarg, "dantzig") == 0) result->rule = RULE_DANTZIG;
+                else if (strcmp(optarg, "steepest") == 0) result->rule = RULE_STEEPEST_EDGE;
+                else if (strcmp(optarg, "devex") == 0) result->rule = RULE_DEVEX;
+                else if (strcmp(optarg, "partial") == 0) result->rule = RULE_PARTIAL;
+                else if (strcmp(optarg, "multiple") == 0) result->rule = RULE_MULTIPLE;
+                else if (strcmp(optarg, "bland") == 0) result->rule = RULE_BLAND;
+                else return result;
+                break;
+            case 'p':
+                if (strcmp(optarg, "double") == 0) result->precision = PRECISION_DOUBLE;
+                else if (strcmp(optarg, "float") == 0) result->precision = PRECISION_FLOAT;
+                else if (strcmp(optarg, "mixed") == 0) result->precision = PRECISION_MIXED;
+                else if (strcmp(optarg, "exact") == 0) result->precision = PRECISION_EXACT;
+                else return result;
+                break;
+            case 'P':
+                if (!parse_tolerance(optarg, &result->pivot_tolerance)) return result;
+                break;
+            case 'F':
+                if (!parse_tolerance(optarg, &result->feasibility_tolerance)) return result;
+                break;
+            case 'M':
+                if (!parse_int(optarg, 1, &result->max_pivots)) return result;
+                break;
+            case 'T':
+                if (!parse_seconds(optarg, &result->time_limit)) return result;
+                break;
+            case 'D':
+                result->presolve = true;
+                break;
+            case 'C':
+                result->cache = optarg;
+                break;
+            case 'X':
+                result->stats = true;
+                break;
+            case 'q':
+                result->trace_every = 0;
+                break;
+            case 'k':
+                if (!parse_int(optarg, 1, &result->trace_every)) return result;
+                break;
+            case 'S':
+                result->start_basis = optarg;
+                break;
+            case 'W':
+                result->save_basis = optarg;
+                break;
+            default: // unknown option or missing argument
+                return result;
+        }
+    }
+
+    // sparse input is pointless if the tableau densifies it
+    if (result->sparse && !engine_set) result->engine = ENGINE_REVISED;
+
+    // a batch or a server has no single basis to start from or save, or
+    // solve to count
+    bool many = result->batch || result->serve != NULL;
+    if (many && (result->start_basis != NULL || result->save_basis != NULL || result->stats)) return result;
+
+    if (result->binary || many) { // sizes come from the input
+        int modes = (int) result->binary + (int) result->batch + (int) (result->serve != NULL);
+        result->success = modes == 1 && !result->sparse && argc == optind;
+        return result;
+    }
+    else if (argc - optind != 2) { // invalid number of arguments
         return result;
     }
     else {
@@ -72,311 +406,1387 @@ ArgResult_t* parse_args(int argc, char** argv) {
         char* n_check = NULL;
 
         // parse row and column numbers
-        long m = strtol(argv[1], &m_check, 10);
-        long n = strtol(argv[2], &n_check, 10);
+        long m = strtol(argv[optind], &m_check, 10);
+        long n = strtol(argv[optind + 1], &n_check, 10);
 
-        if (m_check == argv[1] || n_check == argv[2] || m < 0 || n < 0) {
-            result->success = false;
-            result->m = -1;
-            result->n = -1;
+        if (m_check == argv[optind] || n_check == argv[optind + 1] || m < 0 || n < 0) {
             return result;
         }
         else {
             result->success = true;
-	        result->m = m;
-	        result->n = n;
+            result->m = m;
+            result->n = n;
             return result;
         }
-	}
+    }
+}
+
+
+/**
+ * Struct for storing the whole of an input stream in memory
+ *
+ * data: contents, not null terminated
+ * size: number of bytes in data
+ * mapped: data is a mapping of the file rather than a heap buffer
+ */
+struct Input {
+    char* data;
+    size_t size;
+    bool mapped;
+};
+typedef struct Input Input_t;
+
+/**
+ * Reads an input stream in one go, mapping it when it is a regular file and
+ * reading it in large blocks otherwise
+ *
+ * fd: file descriptor to read until end of file
+ *
+ * return: input struct, NULL if reading failed
+ */
+Input_t* read_input(int fd) {
+    Input_t* input = (Input_t*) malloc(sizeof(Input_t));
+    input->data = NULL;
+    input->size = 0;
+    input->mapped = false;
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            madvise(data, (size_t) info.st_size, MADV_SEQUENTIAL);
+            input->data = (char*) data;
+            input->size = (size_t) info.st_size;
+            input->mapped = true;
+            return input;
+        }
+    }
+
+    // pipes and anything that cannot be mapped
+    size_t capacity = INPUT_BLOCK_SIZE;
+    input->data = (char*) malloc(capacity);
+    while (true) {
+        if (input->size == capacity) {
+            capacity *= 2;
+            input->data = (char*) realloc(input->data, capacity);
+        }
+
+        ssize_t count = read(fd, input->data + input->size, capacity - input->size);
+        if (count == 0) break;
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            free(input->data);
+            free(input);
+            return NULL;
+        }
+        input->size += (size_t) count;
+    }
+    return input;
 }
 
 /**
- * Struct for storing the result the payoff matrix entry
+ * Frees an input struct
+ *
+ * input: struct to free, may be NULL
+ */
+void free_input(Input_t* input) {
+    if (input == NULL) return;
+
+    if (input->mapped) munmap(input->data, input->size);
+    else free(input->data);
+    free(input);
+}
+
+/**
+ * Header of a binary payoff file, stored little endian at the start of the
+ * file. A dense body follows with m * n row-major values. A sparse body
+ * follows with count row indices, then count column indices, both int32, then
+ * count values.
+ *
+ * magic: BINARY_MAGIC
+ * version: BINARY_VERSION
+ * m: number of rows
+ * n: number of columns
+ * dtype: Dtype_t of the values
+ * flags: BINARY_SPARSE for a sparse body, otherwise 0
+ * count: number of entries in a sparse body, 0 for a dense body
+ */
+struct BinaryHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t m;
+    uint32_t n;
+    uint32_t dtype;
+    uint32_t flags;
+    uint64_t count;
+};
+typedef struct BinaryHeader BinaryHeader_t;
+
+/**
+ * Struct for storing the result the payoff matrix entry, either a dense
+ * row-major matrix or the triples of a sparse one
  *
  * success: entry of payoff matrix was successful
- * payoff: payoff matrix
  * m: number of rows
  * n: number of columns
+ * payoff: row-major payoff matrix, NULL if the sparse form was entered
+ * dtype: type of the entries of payoff
+ * count: number of sparse entries
+ * rows: row of each sparse entry, NULL if the dense form was entered
+ * cols: column of each sparse entry
+ * values: value of each sparse entry
+ * input: input payoff points into, NULL if payoff was allocated
  */
 struct PayoffResult {
     bool success;
-    double** payoff;
     int m;
     int n;
+    const void* payoff;
+    Dtype_t dtype;
+    size_t count;
+    int* rows;
+    int* cols;
+    double* values;
+    Input_t* input;
 };
 typedef struct PayoffResult PayoffResult_t;
 
+/**
+ * Creates an empty PayoffResult struct
+ *
+ * m: number of rows
+ * n: number of columns
+ *
+ * return: payoff result structure with neither form filled in
+ */
+PayoffResult_t* create_payoff_result(int m, int n) {
+    PayoffResult_t* result = (PayoffResult_t*) calloc(1, sizeof(PayoffResult_t));
+    result->m = m;
+    result->n = n;
+    result->dtype = DTYPE_FLOAT64;
+    return result;
+}
+
 /**
  * Frees a PayoffResult struct
  *
  * result: payoff result structure
  */
 void free_payoff_result(PayoffResult_t* result) { 
-    free_2d_arr((void**) result->payoff, result->m);
+    if (result->input != NULL) free_input(result->input);
+    else free((void*) result->payoff);
+    free(result->rows);
+    free(result->cols);
+    free(result->values);
     free(result);
 }
 
 /**
- * Prompt user for payoff matrix and process its entry.
+ * Prompt user for payoff matrix and process its entry. Entries may be any
+ * decimal numbers. Input from a terminal is read a line at a time, anything
+ * else is read in one go and parsed in place.
  *
  * m: number of rows
  * n: number of columns
+ * prompt: print the prompt before reading
  *
  * return: payoff result structure
  */
-PayoffResult_t* get_payoff(int m, int n) {
+PayoffResult_t* get_payoff(int m, int n, bool prompt) {
     // initialize result struct
-    PayoffResult_t* result = (PayoffResult_t*) malloc(sizeof(PayoffResult_t));
-    result->payoff = (double**) calloc(m, sizeof(double*));
-    result->m = m;
-    result->n = n;
+    PayoffResult_t* result = create_payoff_result(m, n);
+    double* payoff = (double*) calloc((size_t) m * n, sizeof(double));
+    result->payoff = payoff;
+    result->success = true;
 
-    printf("Enter the %d by %d payoff matrix below. Separate rows by new lines and columns by spaces: \n", m, n);
-    
-    int buffer_size = 1000;
-    char* row_string = (char*) calloc(buffer_size, sizeof(char));
-    for (int row = 0; row < m; row++) {
-        result->payoff[row] = (double*) calloc(n, sizeof(double));
+    if (prompt) {
+        printf("Enter the %d by %d payoff matrix below. Separate rows by new lines and columns by spaces: \n", m, n);
+        fflush(stdout);
+    }
 
-        // read in next row
-        getline(&row_string, &buffer_size, stdin);
+    if (isatty(STDIN_FILENO)) { // typed in, so do not wait for end of input
+        size_t buffer_size = 0;
+        char* line = NULL;
+        for (int row = 0; row < m && result->success; row++) {
+            ssize_t length = getline(&line, &buffer_size, stdin);
+            if (length < 0 || !parse_row(line, line + length, payoff + (size_t) row * n, n)) result->success = false;
+        }
+        free(line);
+        return result;
+    }
 
-        char* to_tokenize = row_string;
-        for (int col = 0; col < n; col++) {
-            // get next token in row
-            char* number_string = strtok(to_tokenize, " ");
-            if (number_string == NULL) { // no token
-                result->success = false;
-                goto safe_exit;
-            }
+    Input_t* input = read_input(STDIN_FILENO);
+    if (input == NULL) {
+        result->success = false;
+        return result;
+    }
 
-            // parse number from string
-            char* number_check = NULL;
-            long number = strtol(number_string, &number_check, 10);
+    const char* cursor = input->data;
+    const char* end = input->data + input->size;
+    for (int row = 0; row < m && result->success; row++) {
+        const char* line_end = find_line_end(cursor, end);
+
+        if (!parse_row(cursor, line_end, payoff + (size_t) row * n, n)) result->success = false;
+        cursor = (line_end < end)? line_end + 1 : end;
+    }
+
+    free_input(input);
+    return result;
+}
 
-            if (number_string == number_check) { // no number
-                result->success = false;
+/**
+ * Prompt user for the nonzero entries of a sparse payoff matrix and process
+ * their entry, one "row column value" triple per line until end of input.
+ * Rows and columns count from 0 and blank lines are skipped.
+ *
+ * m: number of rows
+ * n: number of columns
+ * prompt: print the prompt before reading
+ *
+ * return: payoff result structure with only the sparse form filled in
+ */
+PayoffResult_t* get_sparse_payoff(int m, int n, bool prompt) {
+    // initialize result struct
+    PayoffResult_t* result = create_payoff_result(m, n);
+
+    if (prompt) {
+        printf("Enter the nonzero entries of the %d by %d payoff matrix below. Put one row, column and value on each line: \n", m, n);
+        fflush(stdout);
+    }
+
+    Input_t* input = read_input(STDIN_FILENO);
+    if (input == NULL) return result;
+
+    size_t capacity = 1024;
+    size_t count = 0;
+    int* rows = (int*) calloc(capacity, sizeof(int));
+    int* cols = (int*) calloc(capacity, sizeof(int));
+    double* values = (double*) calloc(capacity, sizeof(double));
+
+    const char* cursor = input->data;
+    const char* end = input->data + input->size;
+    while (cursor < end) {
+        const char* line_end = find_line_end(cursor, end);
+
+        cursor = skip_blanks(cursor, line_end);
+        if (cursor < line_end) { // not a blank line
+            int row, col;
+            double value;
+            bool valid = parse_index(&cursor, line_end, &row);
+            cursor = skip_blanks(cursor, line_end);
+            valid = valid && parse_index(&cursor, line_end, &col);
+            cursor = skip_blanks(cursor, line_end);
+            valid = valid && parse_number(&cursor, line_end, &value);
+
+            if (!valid || skip_blanks(cursor, line_end) != line_end || row >= m || col >= n) // bad triple
                 goto safe_exit;
-            }
-            else {
-                // put number in matrix
-                result->payoff[row][col] = (double) number;
-            }
 
-            to_tokenize = NULL;
+            if (count == capacity) {
+                capacity *= 2;
+                rows = (int*) realloc(rows, capacity * sizeof(int));
+                cols = (int*) realloc(cols, capacity * sizeof(int));
+                values = (double*) realloc(values, capacity * sizeof(double));
+            }
+            rows[count] = row;
+            cols[count] = col;
+            values[count++] = value;
         }
+
+        cursor = (line_end < end)? line_end + 1 : end;
     }
 
-    result->success = true; 
+    result->count = count;
+    result->rows = rows;
+    result->cols = cols;
+    result->values = values;
+    result->success = true;
+    free_input(input);
+    return result;
 safe_exit:
-    free(row_string);
+    free(rows);
+    free(cols);
+    free(values);
+    free_input(input);
     return result;
 }
 
 /**
- * Struct for storing a tableau
+ * Checks the header of a binary payoff and finds the size of the body that
+ * follows it, without overflowing on a huge size or count
+ *
+ * header: header to check
+ * body_size: filled with the number of bytes in the body
  *
- * m: matrix
- * s_size: length of S
- * x_size: length of X
- * rows: number of rows in m
- * cols: number of columns in m
+ * return: if the header is valid
  */
-struct Tableau {
-    double** m;
-    int s_size;
-    int x_size;
-    int rows;
-    int cols;
-    int k;
-};
-typedef struct Tableau Tableau_t;
+bool check_binary_header(const BinaryHeader_t* header, size_t* body_size) {
+    if (memcmp(header->magic, BINARY_MAGIC, 4) != 0 || header->version != BINARY_VERSION ||
+        header->m == 0 || header->m > INT_MAX || header->n == 0 || header->n > INT_MAX ||
+        header->dtype > DTYPE_FLOAT32 || (header->flags & ~BINARY_SPARSE) != 0)
+        return false;
+
+    size_t element = (header->dtype == DTYPE_FLOAT64)? sizeof(double) : sizeof(float);
+    if (!(header->flags & BINARY_SPARSE)) {
+        if (header->count != 0 || header->m > SIZE_MAX / header->n / element) return false;
+        *body_size = (size_t) header->m * header->n * element;
+    }
+    else {
+        // m and n are at most INT_MAX, so their product fits in 64 bits
+        size_t entry = 2 * sizeof(int32_t) + element;
+        if (header->count > (uint64_t) header->m * header->n || header->count > SIZE_MAX / entry) return false;
+        *body_size = (size_t) header->count * entry;
+    }
+    return true;
+}
 
 /**
- * Initialize a new tableau
+ * Loads the body of a binary payoff. A dense matrix stays in the body, and a
+ * sparse one is converted right away.
  *
- * s_size: length of S
- * x_size: length of X
+ * header: checked header of the payoff
+ * body: body following the header, of the size check_binary_header found
+ * result: filled with either form, and successful unless a sparse entry is
+ *         out of range
  */
-Tableau_t* create_tableau(int s_size, int x_size) {
-    Tableau_t* tableau = (Tableau_t*) malloc(sizeof(Tableau_t));
-    tableau->s_size = s_size;
-    tableau->x_size = x_size;
-    tableau->rows = s_size + 1;
-    tableau->cols = x_size + s_size + 1;
-    tableau->k = 0;
+void load_binary_body(const BinaryHeader_t* header, const char* body, PayoffResult_t* result) {
+    int m = (int) header->m;
+    int n = (int) header->n;
+    if (!(header->flags & BINARY_SPARSE)) {
+        result->payoff = body;
+        result->dtype = (Dtype_t) header->dtype;
+        result->m = m;
+        result->n = n;
+        result->success = true;
+        return;
+    }
 
-    tableau->m = (double**) calloc(tableau->rows, sizeof(double*));
-    for (int row = 0; row < tableau->rows; row++) {
-        tableau->m[row] = (double*) calloc(tableau->cols, sizeof(double));
-        for (int col = 0; col < tableau->cols; col++)
-            tableau->m[row][col] = 0;
+    size_t count = (size_t) header->count;
+    const int32_t* rows = (const int32_t*) body;
+    const int32_t* cols = rows + count;
+    int* entry_rows = (int*) calloc(count, sizeof(int));
+    int* entry_cols = (int*) calloc(count, sizeof(int));
+    double* entry_values = (double*) calloc(count, sizeof(double));
+    bool valid = true;
+    for (size_t entry = 0; entry < count && valid; entry++) {
+        entry_rows[entry] = rows[entry];
+        entry_cols[entry] = cols[entry];
+        entry_values[entry] = (header->dtype == DTYPE_FLOAT64)?
+            ((const double*) (cols + count))[entry] : ((const float*) (cols + count))[entry];
+        valid = rows[entry] >= 0 && rows[entry] < m && cols[entry] >= 0 && cols[entry] < n;
     }
 
-    return tableau;
+    result->count = count;
+    result->rows = entry_rows;
+    result->cols = entry_cols;
+    result->values = entry_values;
+    if (valid) {
+        result->m = m;
+        result->n = n;
+        result->success = true;
+    }
 }
 
 /**
- * Frees a tableau struct
+ * Reads a payoff matrix in the binary format described by BinaryHeader_t.
+ * A dense matrix stays in the input, mapped when it is a regular file, and a
+ * sparse one is converted right away.
  *
- * tableau: struct to free
+ * return: payoff result structure with either form filled in
  */
-void free_tableau(Tableau_t* tableau) {
-    free_2d_arr((void**) tableau->m, tableau->rows);
-    free(tableau);
+PayoffResult_t* get_binary_payoff() {
+    // initialize result struct
+    PayoffResult_t* result = create_payoff_result(0, 0);
+
+    Input_t* input = read_input(STDIN_FILENO);
+    if (input == NULL) return result;
+
+    BinaryHeader_t header;
+    size_t body_size;
+    if (input->size < sizeof(BinaryHeader_t)) goto safe_exit;
+    memcpy(&header, input->data, sizeof(BinaryHeader_t));
+    if (!check_binary_header(&header, &body_size) || input->size - sizeof(BinaryHeader_t) != body_size) goto safe_exit;
+
+    load_binary_body(&header, input->data + sizeof(BinaryHeader_t), result);
+    if (result->payoff != NULL) {
+        result->input = input;
+        return result;
+    }
+safe_exit:
+    free_input(input);
+    return result;
 }
 
+
 /**
- * Prints the tableau matrix
+ * Reads a basis saved by write_basis, one "row column" pivot per line.
+ * Blank lines are skipped.
+ *
+ * path: file to read
+ * basis: filled with the pivots, free its rows and cols when done
  *
- * tableau: struct to print
+ * return: if the file was read and every line held a pivot
  */
-void print_tableau(Tableau_t* tableau) {
-    // build divider
-    int length = (7 * tableau->cols) + 3;
-    char* row_divider = (char*) calloc(length, sizeof(char));
-    memset(row_divider, (int) '-', length - 1);
+bool read_basis(const char* path, SolveBasis_t* basis) {
+    basis->count = 0;
+    basis->rows = NULL;
+    basis->cols = NULL;
 
-    for (int row = 0; row < tableau->rows; row++) {
-        if (row == tableau->s_size) printf("%s\n", row_divider);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    Input_t* input = read_input(fd);
+    close(fd);
+    if (input == NULL) return false;
 
-        for (int col = 0; col < tableau->cols; col++) {
-            if (col == tableau->x_size || col == tableau->x_size + tableau->s_size) printf("|");
-            printf("%6.2f ", tableau->m[row][col]);
+    int capacity = 0;
+    bool valid = true;
+    const char* cursor = input->data;
+    const char* end = input->data + input->size;
+    while (cursor < end) {
+        const char* line_end = find_line_end(cursor, end);
+
+        cursor = skip_blanks(cursor, line_end);
+        if (cursor < line_end) { // not a blank line
+            int row, col;
+            valid = parse_index(&cursor, line_end, &row);
+            cursor = skip_blanks(cursor, line_end);
+            valid = valid && parse_index(&cursor, line_end, &col) && skip_blanks(cursor, line_end) == line_end;
+            if (!valid) break;
+
+            if (basis->count == capacity) {
+                capacity = (capacity > 0)? capacity * 2 : 64;
+                basis->rows = (int*) realloc(basis->rows, capacity * sizeof(int));
+                basis->cols = (int*) realloc(basis->cols, capacity * sizeof(int));
+            }
+            basis->rows[basis->count] = row;
+            basis->cols[basis->count++] = col;
         }
-        printf("\n");
+
+        cursor = (line_end < end)? line_end + 1 : end;
     }
 
-    free(row_divider);
+    free_input(input);
+    return valid;
 }
 
 /**
- * Builds the initial tableau using the given payoff matrix
+ * Writes a basis as one "row column" pivot per line
+ *
+ * path: file to write
+ * basis: pivots to write
  *
- * payoff: payoff matrix
+ * return: if the file was written
+ */
+bool write_basis(const char* path, const SolveBasis_t* basis) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) return false;
+
+    for (int index = 0; index < basis->count; index++)
+        fprintf(file, "%d %d\n", basis->rows[index], basis->cols[index]);
+    return fclose(file) == 0;
+}
+
+/**
+ * Struct for reading a stream of games, each a line holding m and n followed
+ * by m lines of n numbers
+ *
+ * input: whole input stream
+ * cursor: start of the next game in input
+ */
+struct Batch {
+    Input_t* input;
+    const char* cursor;
+};
+typedef struct Batch Batch_t;
+
+/**
+ * Struct for a game found in a batch, before its payoff matrix is parsed
+ *
+ * start: first line of the payoff matrix in the batch input
  * m: number of rows
  * n: number of columns
+ */
+struct BatchGame {
+    const char* start;
+    int m;
+    int n;
+};
+typedef struct BatchGame BatchGame_t;
+
+/**
+ * Struct for storing dense payoff matrices of changing size in one block,
+ * grown to the largest matrix so far
+ *
+ * values: row-major storage for the payoff matrix
+ * capacity: number of doubles allocated for values
+ */
+struct PayoffBuffer {
+    double* values;
+    size_t capacity;
+};
+typedef struct PayoffBuffer PayoffBuffer_t;
+
+/**
+ * Starts reading a batch of games from standard input
+ *
+ * return: batch struct, NULL if the input could not be read
+ */
+Batch_t* create_batch() {
+    Input_t* input = read_input(STDIN_FILENO);
+    if (input == NULL) return NULL;
+
+    Batch_t* batch = (Batch_t*) malloc(sizeof(Batch_t));
+    batch->input = input;
+    batch->cursor = input->data;
+    return batch;
+}
+
+/**
+ * Frees a batch struct and its input
+ *
+ * batch: struct to free
+ */
+void free_batch(Batch_t* batch) {
+    free_input(batch->input);
+    free(batch);
+}
+
+/**
+ * Finds the next game of a batch by its size line, skipping over its payoff
+ * matrix without parsing it
+ *
+ * batch: batch to read from
+ * game: filled with the size and position of the game
+ *
+ * return: 1 if a game was found, 0 at the end of input, -1 on a bad size line
+ *         or too few lines
+ */
+int scan_batch_game(Batch_t* batch, BatchGame_t* game) {
+    const char* end = batch->input->data + batch->input->size;
+
+    // find the size line, skipping blank lines
+    const char* line_end;
+    while (true) {
+        if (batch->cursor == end) return 0;
+        line_end = find_line_end(batch->cursor, end);
+        batch->cursor = skip_blanks(batch->cursor, line_end);
+        if (batch->cursor < line_end) break;
+        batch->cursor = (line_end < end)? line_end + 1 : end;
+    }
+
+    bool valid = parse_index(&batch->cursor, line_end, &game->m);
+    batch->cursor = skip_blanks(batch->cursor, line_end);
+    valid = valid && parse_index(&batch->cursor, line_end, &game->n);
+    if (!valid || skip_blanks(batch->cursor, line_end) != line_end || game->m == 0 || game->n == 0) return -1;
+    batch->cursor = (line_end < end)? line_end + 1 : end;
+
+    game->start = batch->cursor;
+    for (int row = 0; row < game->m; row++) {
+        if (batch->cursor == end) return -1;
+        line_end = find_line_end(batch->cursor, end);
+        batch->cursor = (line_end < end)? line_end + 1 : end;
+    }
+    return 1;
+}
+
+/**
+ * Parses the payoff matrix of a game found by scan_batch_game
  *
- * return: initial tableau
+ * batch: batch the game was found in
+ * game: game to parse
+ * buffer: storage for the payoff matrix, grown if needed
+ * result: filled with the dense payoff matrix, owned by buffer
+ *
+ * return: if every line held n valid numbers
  */
-Tableau_t* get_init_tableau(double** payoff, int m, int n) {
-    Tableau_t* tableau = create_tableau(m, n); 
+bool load_batch_game(Batch_t* batch, const BatchGame_t* game, PayoffBuffer_t* buffer, PayoffResult_t* result) {
+    int m = game->m;
+    int n = game->n;
+
+    size_t size = (size_t) m * n;
+    if (size > buffer->capacity) {
+        free(buffer->values);
+        buffer->values = (double*) calloc(size, sizeof(double));
+        buffer->capacity = size;
+    }
 
-    // find minimum payoff value
-    double min = DBL_MAX;
+    const char* end = batch->input->data + batch->input->size;
+    const char* cursor = game->start;
     for (int row = 0; row < m; row++) {
-        for (int col = 0; col < n; col++) {
-            if (payoff[row][col] < min) min = payoff[row][col];
-        }
+        const char* line_end = find_line_end(cursor, end);
+        if (!parse_row(cursor, line_end, buffer->values + (size_t) row * n, n)) return false;
+        cursor = (line_end < end)? line_end + 1 : end;
     }
-    double k = (min < 1)? 1 - min : 0;
-    tableau->k = k;
 
-    // populate initial tableau
-    for (int row = 0; row < tableau->rows; row++) {
-        for (int col = 0; col < tableau->cols; col++) {
-            if (col < n) tableau->m[row][col] = (row < m)? payoff[row][col] + k : -1;
-            else if (col < n + m) tableau->m[row][col] = (row < m)? (double) (row == col - n) : 0;
-            else tableau->m[row][col] = (double) (row < m);
-        }
+    memset(result, 0, sizeof(PayoffResult_t));
+    result->success = true;
+    result->m = m;
+    result->n = n;
+    result->payoff = buffer->values;
+    result->dtype = DTYPE_FLOAT64;
+    return true;
+}
+
+
+/**
+ * Struct for storing the solution of a game, grown to the largest game so far
+ *
+ * result: strategies, value and pivot count of the game
+ * m: number of rows
+ * n: number of columns
+ * row_capacity: number of entries allocated for the p1 strategy
+ * col_capacity: number of entries allocated for the p2 strategy
+ */
+struct Solution {
+    SolveResult_t result;
+    int m;
+    int n;
+    int row_capacity;
+    int col_capacity;
+};
+typedef struct Solution Solution_t;
+
+/**
+ * Solves a payoff matrix as it was entered, dense or sparse
+ *
+ * workspace: buffers to solve in
+ * payoff: payoff matrix to solve
+ * options: options to solve with
+ * solution: filled with the solution, grown if needed
+ *
+ * return: if the game was solved
+ */
+bool solve_payoff(Workspace_t* workspace, const PayoffResult_t* payoff, const SolveOptions_t* options, Solution_t* solution) {
+    int m = payoff->m;
+    int n = payoff->n;
+
+    if (m > solution->row_capacity) {
+        free(solution->result.p1_strategy);
+        solution->result.p1_strategy = (double*) calloc(m, sizeof(double));
+        solution->row_capacity = m;
     }
+    if (n > solution->col_capacity) {
+        free(solution->result.p2_strategy);
+        solution->result.p2_strategy = (double*) calloc(n, sizeof(double));
+        solution->col_capacity = n;
+    }
+    solution->m = m;
+    solution->n = n;
 
-    return tableau;
+    if (payoff->payoff != NULL)
+        return solve_dense_game(workspace, payoff->payoff, payoff->dtype, m, n, options, &solution->result);
+    return solve_sparse_game(workspace, m, n, payoff->count, payoff->rows, payoff->cols, payoff->values,
+                             options, &solution->result);
 }
 
 /**
- * Struct to store a pivot result
+ * Frees the strategies and basis of a solution
  *
- * success: if the pivot was successful
- * tableau: tableau resulting from pivot\
- * pivot_row: row of the pivot used
- * pivot_col: col of the pivot used
+ * solution: struct whose buffers to free
  */
-struct PivotResult {
-    bool success;
-    Tableau_t* tableau;
-    int pivot_row;
-    int pivot_col;
+void free_solution(Solution_t* solution) {
+    free(solution->result.p1_strategy);
+    free(solution->result.p2_strategy);
+    free(solution->result.basis.rows);
+    free(solution->result.basis.cols);
+}
+
+/**
+ * Prints a strategy as a parenthesized list
+ *
+ * stream: where to print
+ * strategy: probabilities to print
+ * length: number of entries in strategy
+ */
+void print_strategy(FILE* stream, const double* strategy, int length) {
+    char separator[3] = "";
+    fprintf(stream, "( ");
+    for (int index = 0; index < length; index++) {
+        fprintf(stream, "%s%4.2f", separator, strategy[index]);
+        strcpy(separator, ", ");
+    }
+    fprintf(stream, " )");
+}
+
+/**
+ * Prints the solution of a single game
+ *
+ * solution: solution to print
+ */
+void print_solution(const Solution_t* solution) {
+    printf("Player 1 Optimal Strategy: ");
+    print_strategy(stdout, solution->result.p1_strategy, solution->m);
+    printf("\n");
+
+    printf("Player 2 Optimal Strategy: ");
+    print_strategy(stdout, solution->result.p2_strategy, solution->n);
+    printf("\n");
+
+    printf("Value: %5.2f\n", solution->result.value);
+    printf("Pivots: %d\n", solution->result.pivots);
+}
+
+/**
+ * Prints whether a game was solved exactly, with its value as a fraction
+ * when it is known
+ *
+ * result: result of solving the game
+ */
+void print_exact(const SolveResult_t* result) {
+    if (!result->exact) printf("Exact: no\n");
+    else if (result->value_denominator == 0) printf("Exact: yes\n");
+    else printf("Exact Value: %lld/%lld\n", result->value_numerator, result->value_denominator);
+}
+
+/**
+ * Describes the limit a solve stopped at
+ *
+ * status: status of the solve, a limit
+ *
+ * return: sentence fragment naming the limit
+ */
+const char* limit_message(SolveStatus_t status) {
+    return (status == SOLVE_TIME_LIMIT)? "Time limit reached" : "Pivot limit reached";
+}
+
+/**
+ * Gets the exit status of a solve
+ *
+ * status: status of the solve
+ *
+ * return: 0 unless the solve stopped at a limit
+ */
+int exit_status(SolveStatus_t status) {
+    if (status == SOLVE_PIVOT_LIMIT) return EXIT_PIVOT_LIMIT;
+    if (status == SOLVE_TIME_LIMIT) return EXIT_TIME_LIMIT;
+    return 0;
+}
+
+/**
+ * Prints the solution of a game in a batch as a one line record, or the
+ * limit it stopped at
+ *
+ * stream: where to print
+ * index: position of the game in the batch, counting from 1
+ * solution: solution to print
+ */
+void print_record(FILE* stream, int index, const Solution_t* solution) {
+    if (!solution->result.success) {
+        fprintf(stream, "Game %d: %s, Pivots: %d\n", index, limit_message(solution->result.status),
+                solution->result.pivots);
+        return;
+    }
+
+    fprintf(stream, "Game %d: Value: %5.2f, Pivots: %d, Player 1: ", index, solution->result.value, solution->result.pivots);
+    print_strategy(stream, solution->result.p1_strategy, solution->m);
+    fprintf(stream, ", Player 2: ");
+    print_strategy(stream, solution->result.p2_strategy, solution->n);
+    fprintf(stream, "\n");
+}
+
+
+/**
+ * Struct for a game of the batch window being solved
+ *
+ * game: size and position of the game
+ * large: solved with the pivot pool after the other games of the window
+ * valid: payoff matrix parsed, false stops the batch at this game
+ * status: how the solve of the game ended
+ * owner: worker whose records hold the record, threads for the caller
+ * offset: start of the record in the owner's records
+ * length: length of the record
+ */
+struct ScheduledGame {
+    BatchGame_t game;
+    bool large;
+    bool valid;
+    SolveStatus_t status;
+    int owner;
+    long offset;
+    long length;
 };
-typedef struct PivotResult PivotResult_t;
+typedef struct ScheduledGame ScheduledGame_t;
 
 /**
- * Frees a pivot result
+ * Struct for one thread of the batch scheduler. Its games are the range
+ * [next, end) of the window, taken from the front by the thread and stolen
+ * from the back by the others.
  *
- * result: result to be freed
+ * lock: guards next and end
+ * next: next game the thread takes
+ * end: end of the thread's games
+ * id: index of the thread
+ * thread: handle of the thread, unused for thread 0 which is the caller
+ * scheduler: scheduler the thread belongs to
+ * workspace: buffers for solving, reused across games and windows
+ * buffer: storage for payoff matrices, reused across games and windows
+ * solution: storage for the solution of a game, reused across games
+ * records: stream collecting the records of the window
+ * text: contents of records once it is closed
+ * text_size: length of text
  */
-void free_pivot_result(PivotResult_t* result) {
-    free_tableau(result->tableau);
-    free(result);
+struct BatchWorker {
+    pthread_mutex_t lock;
+    int next;
+    int end;
+    int id;
+    pthread_t thread;
+    struct BatchScheduler* scheduler;
+    Workspace_t* workspace;
+    PayoffBuffer_t buffer;
+    Solution_t solution;
+    FILE* records;
+    char* text;
+    size_t text_size;
+};
+typedef struct BatchWorker BatchWorker_t;
+
+/**
+ * Struct for solving the games of a batch on several threads, a window of
+ * games at a time
+ *
+ * batch: batch being solved
+ * options: options every game is solved with
+ * pool_options: options large games are solved with
+ * threads: number of worker threads, including the caller
+ * workers: one per thread, plus one more for the large games the caller
+ *          solves with the pool
+ * games: games of the current window
+ * count: number of games in the window
+ * first: index of the first game of the window in the batch, counting from 0
+ */
+struct BatchScheduler {
+    Batch_t* batch;
+    SolveOptions_t options;
+    SolveOptions_t pool_options;
+    int threads;
+    BatchWorker_t* workers;
+    ScheduledGame_t* games;
+    int count;
+    int first;
+};
+typedef struct BatchScheduler BatchScheduler_t;
+
+/**
+ * Parses, solves and records one game of the window
+ *
+ * worker: thread solving the game
+ * index: position of the game in the window
+ */
+void solve_scheduled_game(BatchWorker_t* worker, int index) {
+    BatchScheduler_t* scheduler = worker->scheduler;
+    ScheduledGame_t* scheduled = &scheduler->games[index];
+
+    PayoffResult_t payoff;
+    scheduled->valid = load_batch_game(scheduler->batch, &scheduled->game, &worker->buffer, &payoff);
+    if (!scheduled->valid) return;
+
+    const SolveOptions_t* options = (scheduled->large)? &scheduler->pool_options : &scheduler->options;
+    solve_payoff(worker->workspace, &payoff, options, &worker->solution);
+    scheduled->status = worker->solution.result.status;
+    scheduled->owner = worker->id;
+    scheduled->offset = ftell(worker->records);
+    print_record(worker->records, scheduler->first + index + 1, &worker->solution);
+    scheduled->length = ftell(worker->records) - scheduled->offset;
 }
 
 /**
- * Pivots the provided tableau
+ * Takes the next game for a thread, from its own range or else by stealing
+ * the back half of another thread's range
+ *
+ * worker: thread looking for work
  *
- * tableau: struct to pivot
+ * return: position of the game in the window, -1 when no work is left
  */
-PivotResult_t* pivot_tableau(Tableau_t* tableau) {
-    PivotResult_t* result = (PivotResult_t*) malloc(sizeof(PivotResult_t));
-    result->tableau = create_tableau(tableau->s_size, tableau->x_size);
-    result->tableau->k = tableau->k;
+int take_scheduled_game(BatchWorker_t* worker) {
+    BatchScheduler_t* scheduler = worker->scheduler;
+
+    pthread_mutex_lock(&worker->lock);
+    int index = (worker->next < worker->end)? worker->next++ : -1;
+    pthread_mutex_unlock(&worker->lock);
+    if (index >= 0) return index;
 
-    // find pivot column
-    double min_value = 0; // trying to find most negative number
-    int pivot_col = -1;
+    // work only moves between ranges, so one empty pass means it is all taken
+    for (int offset = 1; offset < scheduler->threads; offset++) {
+        BatchWorker_t* victim = &scheduler->workers[(worker->id + offset) % scheduler->threads];
 
-    for (int col = 0; col < tableau->cols; col++) {
-        double value = tableau->m[tableau->rows - 1][col];
-        if (value < min_value) {
-            min_value = value;
-            pivot_col = col;
+        pthread_mutex_lock(&victim->lock);
+        int remaining = victim->end - victim->next;
+        int start = victim->end - remaining / 2;
+        int end = victim->end;
+        if (remaining == 1) start = victim->next++; // last game, take it whole
+        else victim->end = start;
+        pthread_mutex_unlock(&victim->lock);
+
+        if (remaining <= 0) continue;
+        if (remaining == 1) return start;
+
+        pthread_mutex_lock(&worker->lock);
+        worker->next = start + 1;
+        worker->end = end;
+        pthread_mutex_unlock(&worker->lock);
+        return start;
+    }
+    return -1;
+}
+
+/**
+ * Thread body of the batch scheduler, solving games until none are left
+ *
+ * argument: the thread's BatchWorker_t
+ *
+ * return: NULL
+ */
+void* batch_worker(void* argument) {
+    BatchWorker_t* worker = (BatchWorker_t*) argument;
+
+    int index;
+    while ((index = take_scheduled_game(worker)) >= 0) {
+        if (!worker->scheduler->games[index].large) solve_scheduled_game(worker, index);
+    }
+    return NULL;
+}
+
+/**
+ * Solves every game of a batch on standard input and prints a record for
+ * each in input order. Games are found a window at a time and spread over
+ * the threads, which steal from each other when they run out. Games too
+ * large for one thread are solved one after another with the pivot pool
+ * once the rest of the window is done.
+ *
+ * options: parsed command line arguments, threads is the number of workers
+ * cache: result cache shared by the workers, NULL for none
+ *
+ * return: exit status of the first game in input order that stopped at a
+ *         limit, 0 if none did
+ */
+int run_batch(const ArgResult_t* options, ResultCache_t* cache) {
+    Batch_t* batch = create_batch();
+    if (batch == NULL) {
+        printf("Please enter a valid batch of games.\n");
+        return 0;
+    }
+
+    // traces of many games are not useful, and workers pivot alone
+    BatchScheduler_t scheduler;
+    get_solve_options(options, cache, &scheduler.pool_options);
+    scheduler.pool_options.trace_every = 0;
+    scheduler.options = scheduler.pool_options;
+    scheduler.options.threads = 1;
+    scheduler.batch = batch;
+    scheduler.threads = options->threads;
+    scheduler.games = (ScheduledGame_t*) calloc(BATCH_WINDOW, sizeof(ScheduledGame_t));
+    scheduler.workers = (BatchWorker_t*) calloc(scheduler.threads + 1, sizeof(BatchWorker_t));
+    scheduler.first = 0;
+    for (int id = 0; id <= scheduler.threads; id++) {
+        BatchWorker_t* worker = &scheduler.workers[id];
+        pthread_mutex_init(&worker->lock, NULL);
+        worker->id = id;
+        worker->scheduler = &scheduler;
+        worker->workspace = create_workspace();
+    }
+
+    int status = 1;
+    int exit_code = 0;
+    bool stopped = false;
+    while (status > 0 && !stopped) {
+        // find the games of the window
+        scheduler.count = 0;
+        while (scheduler.count < BATCH_WINDOW) {
+            ScheduledGame_t* scheduled = &scheduler.games[scheduler.count];
+            status = scan_batch_game(batch, &scheduled->game);
+            if (status <= 0) break;
+
+            size_t cells = (size_t) (scheduled->game.m + 1) * (scheduled->game.n + scheduled->game.m + 1);
+            scheduled->large = options->engine == ENGINE_TABLEAU && scheduler.threads > 1 && cells >= BATCH_LARGE_TABLEAU;
+            scheduled->valid = true;
+            scheduler.count++;
         }
+
+        // deal out even ranges and solve them
+        for (int id = 0; id <= scheduler.threads; id++) {
+            BatchWorker_t* worker = &scheduler.workers[id];
+            worker->next = (id < scheduler.threads)? (int) ((long) scheduler.count * id / scheduler.threads) : 0;
+            worker->end = (id < scheduler.threads)? (int) ((long) scheduler.count * (id + 1) / scheduler.threads) : 0;
+            worker->records = open_memstream(&worker->text, &worker->text_size);
+        }
+        for (int id = 1; id < scheduler.threads; id++)
+            pthread_create(&scheduler.workers[id].thread, NULL, batch_worker, &scheduler.workers[id]);
+        batch_worker(&scheduler.workers[0]);
+        for (int id = 1; id < scheduler.threads; id++)
+            pthread_join(scheduler.workers[id].thread, NULL);
+
+        BatchWorker_t* pool_worker = &scheduler.workers[scheduler.threads];
+        for (int index = 0; index < scheduler.count; index++) {
+            if (scheduler.games[index].large) solve_scheduled_game(pool_worker, index);
+        }
+
+        // print in input order, stopping at the first bad game
+        for (int id = 0; id <= scheduler.threads; id++) fclose(scheduler.workers[id].records);
+        for (int index = 0; index < scheduler.count && !stopped; index++) {
+            ScheduledGame_t* scheduled = &scheduler.games[index];
+            if (scheduled->valid) {
+                fwrite(scheduler.workers[scheduled->owner].text + scheduled->offset, 1, scheduled->length, stdout);
+                if (exit_code == 0) exit_code = exit_status(scheduled->status);
+            }
+            else {
+                status = -1;
+                stopped = true;
+                scheduler.first += index;
+            }
+        }
+        for (int id = 0; id <= scheduler.threads; id++) free(scheduler.workers[id].text);
+        if (!stopped) scheduler.first += scheduler.count;
     }
+    if (status < 0) printf("Game %d: Please enter m and n followed by m lines of n valid numbers.\n", scheduler.first + 1);
 
-    result->pivot_col = pivot_col;
-    // bounds check for pivot column
-    if (pivot_col < 0) {
-        result->success = false;
-        return result;
+    for (int id = 0; id <= scheduler.threads; id++) {
+        BatchWorker_t* worker = &scheduler.workers[id];
+        pthread_mutex_destroy(&worker->lock);
+        free_workspace(worker->workspace);
+        free(worker->buffer.values);
+        free_solution(&worker->solution);
     }
+    free(scheduler.workers);
+    free(scheduler.games);
+    free_batch(batch);
+    return exit_code;
+}
+
+
+/**
+ * Header of the binary result a server sends back for each request, stored
+ * little endian like BinaryHeader_t. The m values of the row player's
+ * strategy follow, then the n of the column player's, as float64, all zero
+ * unless the game was solved.
+ *
+ * magic: RESULT_MAGIC
+ * version: BINARY_VERSION
+ * status: SolveStatus_t of the solve
+ * pivots: number of pivots taken
+ * m: number of rows, 0 for a request whose header was not valid
+ * n: number of columns, 0 for a request whose header was not valid
+ * value: value of the game, 0 unless it was solved
+ */
+struct BinaryResult {
+    char magic[4];
+    uint32_t version;
+    uint32_t status;
+    uint32_t pivots;
+    uint32_t m;
+    uint32_t n;
+    double value;
+};
+typedef struct BinaryResult BinaryResult_t;
 
-    // find pivot row
-    min_value = DBL_MAX; // finding smallest value
-    int pivot_row = -1;
+/**
+ * Struct for one worker of a server, which serves one connection at a time.
+ * Its buffers are kept across requests and connections, so a worker that has
+ * seen a game of some size solves the next of that size without allocating.
+ *
+ * listener: listening socket shared by the workers
+ * thread: handle of the thread, unused for worker 0 which is the caller
+ * options: options every game is solved with
+ * workspace: buffers for solving
+ * solution: storage for the solution of a game
+ * request: bytes read from the connection, from the current request on
+ * request_size: number of bytes in request
+ * request_capacity: number of bytes allocated for request
+ * response: storage for the response to a request
+ * response_capacity: number of bytes allocated for response
+ */
+struct ServerWorker {
+    int listener;
+    pthread_t thread;
+    SolveOptions_t options;
+    Workspace_t* workspace;
+    Solution_t solution;
+    char* request;
+    size_t request_size;
+    size_t request_capacity;
+    char* response;
+    size_t response_capacity;
+};
+typedef struct ServerWorker ServerWorker_t;
+
+// pipe a server is stopped through, readable by every worker once a byte
+// has been written to it
+int server_stop[2] = { -1, -1 };
+
+/**
+ * Stops a server on SIGINT or SIGTERM. Its workers see the stop pipe become
+ * readable, finish what they are doing and return.
+ *
+ * number: signal received
+ */
+void stop_server(int number) {
+    int saved = errno;
+    if (write(server_stop[1], "", 1) < 0) {}
+    errno = saved;
+}
+
+/**
+ * Waits until a socket is ready, the server is stopped or a timeout passes
+ *
+ * socket: socket to wait on
+ * events: POLLIN to wait to read or POLLOUT to wait to write
+ * timeout: milliseconds to wait, -1 to wait until it is ready
+ *
+ * return: false if the server was stopped or the timeout passed first
+ */
+bool wait_for_socket(int socket, short events, int timeout) {
+    struct pollfd fds[2] = { { socket, events, 0 }, { server_stop[0], POLLIN, 0 } };
+    int ready;
+    while ((ready = poll(fds, 2, timeout)) < 0)
+        if (errno != EINTR) return false;
+    return ready > 0 && fds[1].revents == 0;
+}
 
-    for (int row = 0; row < tableau->rows; row++) {
-        double value = tableau->m[row][tableau->cols - 1] / tableau->m[row][pivot_col];
-        if (value > 0 && value < min_value) {
-            min_value = value;
-            pivot_row = row;
+/**
+ * Reads from a connection until the request buffer of a worker holds at
+ * least some number of bytes. Whatever else has arrived is read along with
+ * them, so pipelined requests are read in few calls.
+ *
+ * worker: worker reading the connection
+ * connection: socket to read
+ * size: number of bytes needed
+ *
+ * return: false if the connection closed, failed or sat idle for
+ *         SERVER_IDLE_MS first
+ */
+bool fill_request(ServerWorker_t* worker, int connection, size_t size) {
+    if (size > worker->request_capacity) {
+        size_t capacity = (worker->request_capacity * 2 > size)? worker->request_capacity * 2 : size;
+        char* request = (char*) realloc(worker->request, capacity);
+        if (request == NULL) return false;
+        worker->request = request;
+        worker->request_capacity = capacity;
+    }
+
+    while (worker->request_size < size) {
+        if (!wait_for_socket(connection, POLLIN, SERVER_IDLE_MS)) return false;
+        ssize_t count = read(connection, worker->request + worker->request_size, worker->request_capacity - worker->request_size);
+        if (count == 0) return false;
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return false;
         }
+        worker->request_size += (size_t) count;
     }
+    return true;
+}
 
-    result->pivot_row = pivot_row;
-    // bounds check for pivot row
-    if (pivot_row < 0) {
-        result->success = false;
-        return result;
+/**
+ * Sends the result of a request, the solution of a worker if it solved the
+ * game and otherwise zeros
+ *
+ * worker: worker answering the request
+ * connection: socket to write
+ * status: how the request ended
+ * m: number of rows
+ * n: number of columns
+ *
+ * return: false if the connection closed or failed, or the result could not
+ *         be allocated
+ */
+bool send_result(ServerWorker_t* worker, int connection, SolveStatus_t status, int m, int n) {
+    size_t size = sizeof(BinaryResult_t) + ((size_t) m + n) * sizeof(double);
+    if (size > worker->response_capacity) {
+        free(worker->response);
+        worker->response = (char*) malloc(size);
+        worker->response_capacity = (worker->response != NULL)? size : 0;
+        if (worker->response == NULL) return false;
     }
 
-    // calculate new tableau
-    double pivot_value = tableau->m[pivot_row][pivot_col];
-    
-    // update pivot row 
-    for (int col = 0; col < tableau->cols; col++)
-        result->tableau->m[pivot_row][col] = tableau->m[pivot_row][col] / pivot_value; // update based on other row rule
+    const SolveResult_t* result = &worker->solution.result;
+    bool solved = status == SOLVE_OPTIMAL;
+    BinaryResult_t header;
+    memcpy(header.magic, RESULT_MAGIC, 4);
+    header.version = BINARY_VERSION;
+    header.status = (uint32_t) status;
+    header.pivots = (solved || status == SOLVE_PIVOT_LIMIT || status == SOLVE_TIME_LIMIT)? (uint32_t) result->pivots : 0;
+    header.m = (uint32_t) m;
+    header.n = (uint32_t) n;
+    header.value = (solved)? result->value : 0;
+    memcpy(worker->response, &header, sizeof(header));
 
-    // update other rows
-    for (int row = 0; row < tableau->rows; row++) {
-        for (int col = 0; col < tableau->cols; col++) {
-            if (row != pivot_row) { // update based on other row rule
-                result->tableau->m[row][col] = tableau->m[row][col] - \
-                    (tableau->m[row][pivot_col] * result->tableau->m[pivot_row][col]);
-            }
+    double* strategies = (double*) (worker->response + sizeof(header));
+    if (solved) {
+        memcpy(strategies, result->p1_strategy, m * sizeof(double));
+        memcpy(strategies + m, result->p2_strategy, n * sizeof(double));
+    }
+    else memset(strategies, 0, ((size_t) m + n) * sizeof(double));
+
+    // a client that went away must not raise SIGPIPE
+    for (size_t sent = 0; sent < size;) {
+        if (!wait_for_socket(connection, POLLOUT, SERVER_IDLE_MS)) return false;
+        ssize_t count = send(connection, worker->response + sent, size - sent, MSG_NOSIGNAL);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return false;
         }
+        sent += (size_t) count;
     }
+    return true;
+}
 
-    result->success = true;
-    return result;
+/**
+ * Answers the requests of a connection in order until it closes. Each
+ * request is a binary payoff as described by BinaryHeader_t, and clients
+ * may send more before reading the results of earlier ones. A request with
+ * a header that is not valid, or larger than SERVER_MAX_STRATEGIES or
+ * SERVER_MAX_BODY_BYTES allow, is answered with SOLVE_INVALID and closes the
+ * connection, since where the next request starts is lost. A connection
+ * idle for SERVER_IDLE_MS is closed too.
+ *
+ * worker: worker serving the connection
+ * connection: socket to serve
+ */
+void serve_connection(ServerWorker_t* worker, int connection) {
+    worker->request_size = 0;
+    while (fill_request(worker, connection, sizeof(BinaryHeader_t))) {
+        BinaryHeader_t header;
+        size_t body_size;
+        memcpy(&header, worker->request, sizeof(BinaryHeader_t));
+        if (!check_binary_header(&header, &body_size) || header.m > SERVER_MAX_STRATEGIES ||
+            header.n > SERVER_MAX_STRATEGIES || body_size > SERVER_MAX_BODY_BYTES) {
+            send_result(worker, connection, SOLVE_INVALID, 0, 0);
+            // closing with unread bytes would reset the connection before
+            // the client reads the result, so what has arrived is dropped
+            shutdown(connection, SHUT_WR);
+            while (recv(connection, worker->request, worker->request_capacity, MSG_DONTWAIT) > 0);
+            return;
+        }
+        size_t size = sizeof(BinaryHeader_t) + body_size;
+        if (!fill_request(worker, connection, size)) return;
+
+        // the body starts 32 bytes into the buffer, so its values are aligned
+        PayoffResult_t payoff = { 0 };
+        load_binary_body(&header, worker->request + sizeof(BinaryHeader_t), &payoff);
+        SolveStatus_t status = SOLVE_INVALID;
+        if (payoff.success) {
+            solve_payoff(worker->workspace, &payoff, &worker->options, &worker->solution);
+            status = worker->solution.result.status;
+        }
+        free(payoff.rows);
+        free(payoff.cols);
+        free(payoff.values);
+        if (!send_result(worker, connection, status, (int) header.m, (int) header.n)) return;
+
+        // the next request moves to the front of the buffer
+        worker->request_size -= size;
+        memmove(worker->request, worker->request + size, worker->request_size);
+    }
+}
+
+/**
+ * Thread body of a server worker, serving connections one at a time until
+ * the server is stopped or the listening socket fails
+ *
+ * argument: the thread's ServerWorker_t
+ *
+ * return: NULL
+ */
+void* server_worker(void* argument) {
+    ServerWorker_t* worker = (ServerWorker_t*) argument;
+    while (wait_for_socket(worker->listener, POLLIN, -1)) {
+        // the listener does not block, since another worker may have taken
+        // the connection first
+        int connection = accept(worker->listener, NULL, NULL);
+        if (connection < 0) {
+            if (errno == EBADF || errno == EINVAL || errno == ENOTSOCK) break;
+            continue;
+        }
+        serve_connection(worker, connection);
+        close(connection);
+    }
+    return NULL;
+}
+
+/**
+ * Serves games on a Unix domain socket until stopped by SIGINT or SIGTERM,
+ * which lets the games being solved finish and then removes the socket.
+ * Each worker keeps its own workspace, so a connection's games are solved
+ * on the tableaus of the games before them.
+ *
+ * options: parsed command line arguments, threads is the number of workers,
+ *          each serving one connection at a time
+ * cache: result cache shared by the workers, NULL for none
+ *
+ * return: EXIT_FAILURE if the socket could not be listened on
+ */
+int run_server(const ArgResult_t* options, ResultCache_t* cache) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(options->serve) >= sizeof(address.sun_path)) {
+        printf("Could not listen on %s.\n", options->serve);
+        return EXIT_FAILURE;
+    }
+    strcpy(address.sun_path, options->serve);
+
+    // a socket left by a server that was killed is replaced
+    struct stat info;
+    if (lstat(options->serve, &info) == 0 && S_ISSOCK(info.st_mode)) unlink(options->serve);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 || bind(listener, (struct sockaddr*) &address, sizeof(address)) != 0 ||
+        listen(listener, SERVER_BACKLOG) != 0 || fcntl(listener, F_SETFL, O_NONBLOCK) != 0 ||
+        pipe(server_stop) != 0) {
+        printf("Could not listen on %s.\n", options->serve);
+        if (listener >= 0) close(listener);
+        return EXIT_FAILURE;
+    }
+    fcntl(server_stop[1], F_SETFL, O_NONBLOCK);
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, stop_server);
+    signal(SIGTERM, stop_server);
+
+    // workers pivot alone, like the workers of a batch
+    ServerWorker_t* workers = (ServerWorker_t*) calloc(options->threads, sizeof(ServerWorker_t));
+    for (int id = 0; id < options->threads; id++) {
+        ServerWorker_t* worker = &workers[id];
+        worker->listener = listener;
+        get_solve_options(options, cache, &worker->options);
+        worker->options.trace_every = 0;
+        worker->options.threads = 1;
+        worker->workspace = create_workspace();
+    }
+    printf("Listening on %s\n", options->serve);
+    fflush(stdout);
+
+    for (int id = 1; id < options->threads; id++) pthread_create(&workers[id].thread, NULL, server_worker, &workers[id]);
+    server_worker(&workers[0]);
+    for (int id = 1; id < options->threads; id++) pthread_join(workers[id].thread, NULL);
+
+    for (int id = 0; id < options->threads; id++) {
+        free_workspace(workers[id].workspace);
+        free_solution(&workers[id].solution);
+        free(workers[id].request);
+        free(workers[id].response);
+    }
+    free(workers);
+    close(listener);
+    close(server_stop[0]);
+    close(server_stop[1]);
+    unlink(options->serve);
+    return 0;
+}
+
+/**
+ * Prints the hot path counters of a solve to stderr as a JSON object, which
+ * are all zero unless libsimplex counts them
+ *
+ * stats: counters of the solve
+ * parse_cycles: cycles spent reading the payoff matrix
+ */
+void print_stats(const SolveStats_t* stats, unsigned long long parse_cycles) {
+    fprintf(stderr, "{\"enabled\": %s, \"parse_cycles\": %llu, \"presolve_cycles\": %llu, \"build_cycles\": %llu, "
+            "\"select_cycles\": %llu, \"eliminate_cycles\": %llu, \"extract_cycles\": %llu, \"pivots\": %llu, "
+            "\"degenerate_pivots\": %llu, \"skipped_rows\": %llu, \"allocated_bytes\": %llu}\n",
+            (solve_stats_enabled())? "true" : "false", parse_cycles, stats->presolve_cycles, stats->build_cycles,
+            stats->select_cycles, stats->eliminate_cycles, stats->extract_cycles, stats->pivots,
+            stats->degenerate_pivots, stats->skipped_rows, stats->allocated_bytes);
 }
 
 /**
@@ -385,95 +1795,94 @@ PivotResult_t* pivot_tableau(Tableau_t* tableau) {
  * argc: number of command line arguments
  * argv: array of tokens
  *
- * return: 0 on successful execution
+ * return: 0 on successful execution, EXIT_PIVOT_LIMIT or EXIT_TIME_LIMIT
+ *         when a solve stopped at a limit
  */
 int main(int argc, char** argv) {
+    int exit_code = 0;
 	ArgResult_t* parse_result = parse_args(argc, argv);
-	if (parse_result->success) { // correct command line arguments
-	    PayoffResult_t* payoff_result = get_payoff(parse_result->m, parse_result->n);
-
-        if (payoff_result->success) { // valid payoff matrix 
-            int m = payoff_result->m;
-            int n = payoff_result->n;
-
-            // initialize matrix to keep track of x variable orders
-            int* order = (int*) calloc(n, sizeof(int));
-            memset(order, -1, n * sizeof(int));
-            
-            Tableau_t* tableau = get_init_tableau(payoff_result->payoff, m, n);
-            int pivot_count = 0;
-            PivotResult_t* pivot_result = NULL;
-            while (true) {
-                // print tableau
-                if (pivot_count == 0) printf("Initial Tableau:\n");
-                else printf("Tableau %d:\n", pivot_count);
-                print_tableau(tableau);
-
-                // pivot it
-                pivot_result = pivot_tableau(tableau);
-                if (pivot_result->success) {
-                    printf("Pivot: ( %d, %d )\n\n", pivot_result->pivot_row, pivot_result->pivot_col);
-                    if (pivot_count < n) order[pivot_count] = pivot_result->pivot_row;
-                    
-                    free_tableau(tableau);
-                    tableau = pivot_result->tableau;
-                    free(pivot_result); // dont free nested tableau
-                }
-                else {
-                    free_pivot_result(pivot_result);
-                    break;
-                }
-
-                pivot_count++;
-            }
+    ResultCache_t* cache = NULL;
+    if (parse_result->success && parse_result->cache != NULL &&
+        (cache = create_result_cache(CACHE_BYTES, parse_result->cache)) == NULL) { // unusable cache file
+        printf("Could not open the cache file %s.\n", parse_result->cache);
+        exit_code = EXIT_FAILURE;
+    }
+	else if (parse_result->success && parse_result->batch) { // stream of games
+        setvbuf(stdout, NULL, _IOFBF, STDOUT_BUFFER_SIZE);
+        exit_code = run_batch(parse_result, cache);
+    }
+    else if (parse_result->success && parse_result->serve != NULL) { // games over a socket
+        exit_code = run_server(parse_result, cache);
+    }
+	else if (parse_result->success) { // correct command line arguments
+        // tableaus are written in large blocks, so only flush when full
+        setvbuf(stdout, NULL, _IOFBF, STDOUT_BUFFER_SIZE);
 
-            // process the final tableau and determine strategies and value
-            // note: tableau is the final tableau
-            double v = tableau->m[tableau->rows - 1][tableau->cols - 1]; // V
-            double value = (1 / v) - tableau->k; // calculate value of the game
+        int trace_every = parse_result->trace_every;
+	    PayoffResult_t* payoff_result;
+        unsigned long long parse_start = read_stats_cycles();
+        if (parse_result->binary) payoff_result = get_binary_payoff();
+        else if (parse_result->sparse) payoff_result = get_sparse_payoff(parse_result->m, parse_result->n, trace_every > 0);
+        else payoff_result = get_payoff(parse_result->m, parse_result->n, trace_every > 0);
+        unsigned long long parse_cycles = read_stats_cycles() - parse_start;
 
-            double* p1_strategy = (double*) calloc(m, sizeof(double));
-            double* p2_strategy = (double*) calloc(n, sizeof(double));
+        if (payoff_result->success) { // valid payoff matrix 
+            SolveOptions_t options;
+            get_solve_options(parse_result, cache, &options);
 
-            // calculate p1 strategy
-            for (int index = 0; index < m; index++)
-                p1_strategy[index] = tableau->m[tableau->rows - 1][tableau->x_size + index] / v;
+            SolveBasis_t start = { 0 };
+            if (parse_result->start_basis != NULL) options.start = &start;
+            SolveStats_t stats = { 0 };
+            if (parse_result->stats) options.stats = &stats;
 
-            // calculate p2 strategy
-            for (int index = 0; index < n; index++) {
-                int x_index = order[index];
-                p2_strategy[index] = (x_index >= 0)? tableau->m[x_index][tableau->cols - 1] / v : 0;
+            Solution_t solution = { 0 };
+            if (parse_result->save_basis != NULL) {
+                solution.result.basis.rows = (int*) calloc(payoff_result->m, sizeof(int));
+                solution.result.basis.cols = (int*) calloc(payoff_result->m, sizeof(int));
             }
 
-            // print results
-            // print player 1 strategy
-            char separator[3] = "";
-            printf("Player 1 Optimal Strategy: ( ");
-            for (int index = 0; index < m; index++) {
-                printf("%s%4.2f", separator, p1_strategy[index]);
-                strcpy(separator, ", ");
+            if (options.start != NULL && !read_basis(parse_result->start_basis, &start)) {
+                printf("Please enter a valid basis file.\n");
             }
-            printf(" )\n");
-
-            // print player 2 strategy
-            strcpy(separator, "");
-            printf("Player 2 Optimal Strategy: ( ");
-            for (int index = 0; index < n; index++) {
-                printf("%s%4.2f", separator, p2_strategy[index]);
-                strcpy(separator, ", ");
-            }
-            printf(" )\n");
-
-            // print value
-            printf("Value: %5.2f\n", value);
+            else {
+                Workspace_t* workspace = create_workspace();
+                bool solved = solve_payoff(workspace, payoff_result, &options, &solution);
+                if (options.stats != NULL) print_stats(&stats, parse_cycles);
+                if (solved) {
+                    print_solution(&solution);
+                    if (options.start != NULL) printf("Warm Start: %s\n", (solution.result.warm_started)? "yes" : "no");
+                    if (options.tableau_dir != NULL) printf("Out of Core: %s\n", (solution.result.out_of_core)? "yes" : "no");
+                    if (options.cache != NULL) printf("Cached: %s\n", (solution.result.cached)? "yes" : "no");
+                    if (options.presolve) {
+                        printf("Presolve: removed %d of %d rows and %d of %d columns\n", solution.result.removed_rows,
+                               solution.m, solution.result.removed_cols, solution.n);
+                    }
+                    if (options.precision == PRECISION_EXACT) print_exact(&solution.result);
+                }
+                else if (exit_status(solution.result.status) != 0) {
+                    printf("%s after %d pivots.\n", limit_message(solution.result.status), solution.result.pivots);
+                    exit_code = exit_status(solution.result.status);
+                }
 
-            // free used memory
-            free(p1_strategy);
-            free(p2_strategy);
-            free(order);
+                // the basis a limit stopped at can be the start of the next solve
+                bool stopped = !solved && exit_code != 0;
+                if ((solved || stopped) && parse_result->save_basis != NULL &&
+                    !write_basis(parse_result->save_basis, &solution.result.basis))
+                    printf("Could not save the basis to %s.\n", parse_result->save_basis);
+                free_workspace(workspace);
+            }
+            free(start.rows);
+            free(start.cols);
+            free_solution(&solution);
+        }
+        else if (parse_result->binary) { // invalid binary payoff matrix
+            printf("Please enter a valid binary payoff matrix.\n");
+        }
+        else if (parse_result->sparse) { // invalid sparse payoff matrix
+            printf("Please enter a valid row, column and value on each line.\n");
         }
         else { // invalid payoff matrix
-            printf("Please enter %d valid integers on each line.\n", parse_result->n);
+            printf("Please enter %d valid numbers on each line.\n", parse_result->n);
         }
 
         free_payoff_result(payoff_result);
@@ -482,6 +1891,7 @@ int main(int argc, char** argv) {
         print_usage();
     }
 
+    if (cache != NULL) free_result_cache(cache);
     free(parse_result);
-    return 0;
+    return exit_code;
 }
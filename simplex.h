@@ -0,0 +1,462 @@
+/**
+ * Author: Aidan Lynch
+ *
+ * libsimplex: solves zero-sum two player games described by a payoff matrix
+ * with the simplex method
+ */
+
+#ifndef SIMPLEX_H
+#define SIMPLEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// marks the functions a shared libsimplex exports
+#define SIMPLEX_API __attribute__((visibility("default")))
+
+/**
+ * Simplex implementations that can solve a game
+ *
+ * ENGINE_TABLEAU: full tableau, pivoted in place
+ * ENGINE_REVISED: revised simplex on a factorized basis
+ */
+enum Engine {
+    ENGINE_TABLEAU,
+    ENGINE_REVISED
+};
+typedef enum Engine Engine_t;
+
+/**
+ * Rules for choosing the entering column of a pivot
+ *
+ * RULE_DANTZIG: most negative reduced cost
+ * RULE_STEEPEST_EDGE: most negative reduced cost per unit length of the edge
+ * RULE_DEVEX: like steepest edge, with reference weights approximating the
+ *             edge lengths
+ * RULE_PARTIAL: most negative reduced cost within a window of columns,
+ *               trying the next window when none is negative
+ * RULE_MULTIPLE: most negative reduced cost among a few candidates kept
+ *                from the last full scan
+ * RULE_BLAND: lowest column with a negative reduced cost, and of the rows
+ *             tied in the ratio test the one whose basic variable is lowest,
+ *             leaving out rows whose pivot is far smaller than the largest.
+ *             It never cycles, so the other rules switch to it when they
+ *             cycle on a degenerate game. A single precision tableau that
+ *             still cycles through rounding has its degenerate right hand
+ *             sides perturbed until it reaches the optimum.
+ */
+enum PivotRule {
+    RULE_DANTZIG,
+    RULE_STEEPEST_EDGE,
+    RULE_DEVEX,
+    RULE_PARTIAL,
+    RULE_MULTIPLE,
+    RULE_BLAND
+};
+typedef enum PivotRule PivotRule_t;
+
+/**
+ * Element types of a dense payoff matrix
+ *
+ * DTYPE_FLOAT64: IEEE double precision
+ * DTYPE_FLOAT32: IEEE single precision
+ */
+enum Dtype {
+    DTYPE_FLOAT64,
+    DTYPE_FLOAT32
+};
+typedef enum Dtype Dtype_t;
+
+/**
+ * Element types the tableau engine pivots in
+ *
+ * PRECISION_DOUBLE: double precision throughout
+ * PRECISION_FLOAT: single precision tableau, which halves the memory each
+ *                  pivot streams through, with results good to about six
+ *                  digits
+ * PRECISION_MIXED: pivots a single precision tableau to its final basis,
+ *                  then refines that basis in double precision with the
+ *                  revised simplex method and checks the strategies against
+ *                  the game, solving with the double precision tableau from
+ *                  that basis if they do not hold
+ * PRECISION_EXACT: pivots exactly in integers, for integer payoffs, which
+ *                  start at 64 bits and widen as the entries grow. Games
+ *                  with other payoffs, or whose entries outgrow 1024 bits,
+ *                  are solved in mixed precision instead.
+ */
+enum Precision {
+    PRECISION_DOUBLE,
+    PRECISION_FLOAT,
+    PRECISION_MIXED,
+    PRECISION_EXACT
+};
+typedef enum Precision Precision_t;
+
+/**
+ * Outcomes of solving a game
+ *
+ * SOLVE_OPTIMAL: the game was solved
+ * SOLVE_INVALID: the game or the workspace could not be solved, like a
+ *                sparse entry out of range
+ * SOLVE_PIVOT_LIMIT: the solve stopped after max_pivots pivots short of the
+ *                    optimum
+ * SOLVE_TIME_LIMIT: the solve stopped at its time limit short of the optimum
+ */
+enum SolveStatus {
+    SOLVE_OPTIMAL,
+    SOLVE_INVALID,
+    SOLVE_PIVOT_LIMIT,
+    SOLVE_TIME_LIMIT
+};
+typedef enum SolveStatus SolveStatus_t;
+
+/**
+ * Struct for a basis, given as the pivots that reach it from the all slack
+ * basis in order, in buffers owned by the caller. Row i of the basis is the
+ * row of payoff row i, and column n + i is the slack of row i.
+ *
+ * count: number of pivots
+ * rows: row of each pivot
+ * cols: column entering the basis at each pivot
+ */
+struct SolveBasis {
+    int count;
+    int* rows;
+    int* cols;
+};
+typedef struct SolveBasis SolveBasis_t;
+
+/**
+ * Struct for the seconds a solve spends in each of its phases
+ *
+ * presolve: removing dominated strategies
+ * build: loading the tableau or factorizing the basis, and moving to the
+ *        start basis
+ * pivot: choosing and taking primal simplex pivots
+ * slowest_pivot: longest single pivot
+ * extract: reading the strategies, value and basis from the final tableau
+ */
+struct SolveTimings {
+    double presolve;
+    double build;
+    double pivot;
+    double slowest_pivot;
+    double extract;
+};
+typedef struct SolveTimings SolveTimings_t;
+
+/**
+ * Struct for the hot path counters of a solve, which are only counted when
+ * libsimplex is built with SIMPLEX_STATS, see solve_stats_enabled. Cycles are
+ * read from the processor's cycle counter, or are nanoseconds on processors
+ * without one.
+ *
+ * presolve_cycles: removing dominated strategies
+ * build_cycles: loading the tableau or factorizing the basis, and moving to
+ *               the start basis
+ * select_cycles: choosing the entering column and leaving row of each pivot
+ * eliminate_cycles: eliminating the pivot column from the other rows
+ * extract_cycles: reading the solution from the final tableau
+ * pivots: pivots taken, counting those reaching the start basis and dual
+ *         simplex pivots
+ * degenerate_pivots: primal pivots that did not grow the objective
+ * skipped_rows: rows an elimination skipped for a zero pivot column entry
+ * allocated_bytes: bytes allocated while solving
+ */
+struct SolveStats {
+    unsigned long long presolve_cycles;
+    unsigned long long build_cycles;
+    unsigned long long select_cycles;
+    unsigned long long eliminate_cycles;
+    unsigned long long extract_cycles;
+    unsigned long long pivots;
+    unsigned long long degenerate_pivots;
+    unsigned long long skipped_rows;
+    unsigned long long allocated_bytes;
+};
+typedef struct SolveStats SolveStats_t;
+
+/**
+ * Cache of solved games, which can be shared by threads solving in their
+ * own workspaces
+ */
+typedef struct ResultCache ResultCache_t;
+
+/**
+ * Struct for the options a game is solved with
+ *
+ * engine: simplex implementation to solve with
+ * rule: rule for choosing the entering column
+ * precision: element type the tableau engine pivots in, the revised engine
+ *            always uses double precision
+ * threads: number of threads the tableau engine pivots with
+ * block_pivots: number of pivots the double precision tableau engine defers
+ *               before applying them together, a cache sized tile of the
+ *               tableau at a time, so a large tableau streams through memory
+ *               once per this many pivots instead of every pivot. The pivots
+ *               are the same, 0 or 1 applies each as it is taken. At most 64
+ *               are deferred, and threads and steepest edge pricing, which
+ *               read the whole tableau every pivot, ignore it.
+ * tableau_dir: directory to keep the double precision tableau in a file in,
+ *              mapped into memory, for games whose tableau does not fit in
+ *              it, NULL to keep it in memory. The file is removed as soon as
+ *              it is made, and pivots stream it a panel of rows at a time,
+ *              reading the next panel ahead and writing the last one back.
+ *              When the file cannot be made the tableau stays in memory.
+ * trace_every: print every this many tableaus and pivots, 0 for none
+ * trace: stream traces are printed to, NULL for none
+ * start: basis to start from, NULL for the all slack basis. It is used when
+ *        it is feasible for the game, which is usually the case when it is
+ *        the final basis of a slightly different game.
+ * pivot_tolerance: pivot column entries at most this cannot pivot, 0 for
+ *                  the default of the precision, 1e-9 in double and 1e-6 in
+ *                  single precision. Exact solves ignore it.
+ * feasibility_tolerance: a basic variable may go this far below zero, which
+ *                        lets the ratio test pick a larger pivot among rows
+ *                        with nearly the same ratio, 0 for the default of
+ *                        the precision. Exact solves ignore it.
+ * max_pivots: most primal simplex pivots to take, 0 for no limit
+ * time_limit: most seconds to spend solving, 0 for no limit
+ * presolve: remove dominated rows and columns before building the tableau,
+ *           and solve a game with a saddle point without pivoting. Sparse
+ *           games are only presolved by the tableau engine, which densifies
+ *           them anyway, and a game presolve shrinks cannot have rows or
+ *           columns appended.
+ * cache: cache dense games are looked up in before solving and added to once
+ *        solved, NULL for none. Games that are shifts or permutations of the
+ *        rows and columns of a cached game are answered from it without
+ *        pivoting, unless their rows or columns are too alike to put in the
+ *        same order. Exact solves do not use it.
+ * timings: filled with the time spent in each phase, NULL for none. Timing
+ *          reads the clock twice per pivot.
+ * stats: filled with the hot path counters of the solve, NULL for none. It
+ *        is left zeroed unless solve_stats_enabled.
+ */
+struct SolveOptions {
+    Engine_t engine;
+    PivotRule_t rule;
+    Precision_t precision;
+    int threads;
+    int block_pivots;
+    const char* tableau_dir;
+    int trace_every;
+    FILE* trace;
+    const SolveBasis_t* start;
+    double pivot_tolerance;
+    double feasibility_tolerance;
+    int max_pivots;
+    double time_limit;
+    bool presolve;
+    ResultCache_t* cache;
+    SolveTimings_t* timings;
+    SolveStats_t* stats;
+};
+typedef struct SolveOptions SolveOptions_t;
+
+/**
+ * Struct for the solution of a game, in buffers owned by the caller
+ *
+ * success: the game was solved
+ * status: how the solve ended, SOLVE_OPTIMAL exactly when success is set.
+ *         The strategies and value are only filled in that case.
+ * p1_strategy: optimal strategy of the row player, m entries
+ * p2_strategy: optimal strategy of the column player, n entries
+ * value: value of the game
+ * pivots: number of pivots taken, not counting those reaching the start basis
+ * warm_started: the start basis was used
+ * exact: the game was solved exactly, so the value is exactly
+ *        value_numerator / value_denominator when those are set, and the
+ *        value and strategies are exact rationals rounded to doubles
+ * value_numerator: numerator of the exact value in lowest terms, 0 if it
+ *                  is not known or does not fit in 64 bits
+ * value_denominator: positive denominator of the exact value, 0 if the
+ *                    numerator is not set
+ * basis: filled with the final basis unless its rows are NULL, its buffers
+ *        must hold m pivots
+ * removed_rows: number of dominated rows presolve removed
+ * removed_cols: number of dominated columns presolve removed
+ * out_of_core: the tableau was kept in a file in SolveOptions_t.tableau_dir
+ * cached: the game was answered from SolveOptions_t.cache without pivoting,
+ *         so nothing was presolved and the workspace holds no tableau to
+ *         append to
+ */
+struct SolveResult {
+    bool success;
+    SolveStatus_t status;
+    double* p1_strategy;
+    double* p2_strategy;
+    double value;
+    int pivots;
+    bool warm_started;
+    bool exact;
+    long long value_numerator;
+    long long value_denominator;
+    SolveBasis_t basis;
+    int removed_rows;
+    int removed_cols;
+    bool out_of_core;
+    bool cached;
+};
+typedef struct SolveResult SolveResult_t;
+
+/**
+ * Buffers reused across the games solved with them, one per thread
+ */
+typedef struct Workspace Workspace_t;
+
+/**
+ * Sets options to the defaults: tableau engine, dantzig's rule, double
+ * precision, one thread, unblocked pivots, the tableau in memory, no trace,
+ * the all slack basis, the default tolerances, no limits, no presolve, no
+ * cache and no timings or stats
+ *
+ * options: struct to fill
+ */
+SIMPLEX_API void default_solve_options(SolveOptions_t* options);
+
+/**
+ * Checks whether libsimplex was built with SIMPLEX_STATS, so that solves
+ * fill SolveOptions_t.stats
+ *
+ * return: true if solves count stats
+ */
+SIMPLEX_API bool solve_stats_enabled();
+
+/**
+ * Reads the counter SolveStats_t cycles are measured with, so callers can
+ * time their own phases in the same unit
+ *
+ * return: current count, 0 unless solve_stats_enabled
+ */
+SIMPLEX_API unsigned long long read_stats_cycles();
+
+/**
+ * Creates a result cache, optionally kept in a file so later processes can
+ * answer the games solved in this one. The file holds every game added to
+ * it, in the byte order of the machine, and the most recent ones that fit
+ * are loaded into memory.
+ *
+ * max_bytes: most memory the cached games may take before the least
+ *            recently used are dropped
+ * path: file to load cached games from and append new ones to, created if
+ *       it does not exist, NULL to keep them in memory only
+ *
+ * return: cache, free with free_result_cache, NULL if the file cannot be
+ *         opened or is not a cache file
+ */
+SIMPLEX_API ResultCache_t* create_result_cache(size_t max_bytes, const char* path);
+
+/**
+ * Frees a result cache and the games it holds, closing its file
+ *
+ * cache: struct to free
+ */
+SIMPLEX_API void free_result_cache(ResultCache_t* cache);
+
+/**
+ * Creates an empty workspace, whose buffers grow to the largest game solved
+ * with it
+ *
+ * return: workspace, free with free_workspace
+ */
+SIMPLEX_API Workspace_t* create_workspace();
+
+/**
+ * Frees a workspace and everything it holds
+ *
+ * workspace: struct to free
+ */
+SIMPLEX_API void free_workspace(Workspace_t* workspace);
+
+/**
+ * Solves a game given by a dense row-major payoff matrix
+ *
+ * payoff: m by n payoff matrix, row-major
+ * m: number of rows
+ * n: number of columns
+ * options: options to solve with, NULL for the defaults
+ * result: filled with the solution, its strategies must hold m and n entries
+ *
+ * return: result->success
+ */
+SIMPLEX_API bool solve_game(const double* payoff, int m, int n, const SolveOptions_t* options, SolveResult_t* result);
+
+/**
+ * Solves a game given by a dense row-major payoff matrix of either element
+ * type, in a workspace
+ *
+ * workspace: buffers to solve in
+ * payoff: m by n payoff matrix, row-major, entries of type dtype
+ * dtype: type of the entries of payoff
+ * m: number of rows
+ * n: number of columns
+ * options: options to solve with, NULL for the defaults
+ * result: filled with the solution, its strategies must hold m and n entries
+ *
+ * return: result->success
+ */
+SIMPLEX_API bool solve_dense_game(Workspace_t* workspace, const void* payoff, Dtype_t dtype, int m, int n,
+                                  const SolveOptions_t* options, SolveResult_t* result);
+
+/**
+ * Solves a game given by the nonzero entries of its payoff matrix, in a
+ * workspace. Repeated entries are summed.
+ *
+ * workspace: buffers to solve in
+ * m: number of rows
+ * n: number of columns
+ * count: number of entries
+ * rows: row of each entry, counting from 0
+ * cols: column of each entry, counting from 0
+ * values: value of each entry
+ * options: options to solve with, NULL for the defaults
+ * result: filled with the solution, its strategies must hold m and n entries
+ *
+ * return: result->success, false if an entry is out of range
+ */
+SIMPLEX_API bool solve_sparse_game(Workspace_t* workspace, int m, int n, size_t count, const int* rows,
+                                   const int* cols, const double* values, const SolveOptions_t* options,
+                                   SolveResult_t* result);
+
+/**
+ * Adds a column to the game last solved in a workspace with the tableau
+ * engine in double precision, then re-optimizes from its final tableau
+ * instead of solving the larger game from scratch. The new column is
+ * nonbasic, so the primal simplex method continues from the old optimum. A
+ * column below the shift the game was solved with shifts the tableau in
+ * place first.
+ *
+ * workspace: workspace the game was solved in
+ * column: payoff of the new column against each row, m entries
+ * options: options to solve with, NULL for the defaults, engine, precision
+ *          and start are ignored
+ * result: filled with the solution, its strategies must hold m and n + 1
+ *         entries
+ *
+ * return: result->success, false if the workspace holds no solved tableau
+ */
+SIMPLEX_API bool append_game_column(Workspace_t* workspace, const double* column, const SolveOptions_t* options,
+                                    SolveResult_t* result);
+
+/**
+ * Adds a row to the game last solved in a workspace with the tableau engine
+ * in double precision, then re-optimizes from its final tableau. The old
+ * optimum stays optimal for the objective but may break the new row, so the
+ * dual simplex method restores feasibility before the primal simplex method
+ * finishes. A row below the shift the game was solved with shifts the
+ * tableau first.
+ *
+ * workspace: workspace the game was solved in
+ * payoff_row: payoff of the new row against each column, n entries
+ * options: options to solve with, NULL for the defaults, engine, precision
+ *          and start are ignored
+ * result: filled with the solution, its strategies must hold m + 1 and n
+ *         entries
+ *
+ * return: result->success, false if the workspace holds no solved tableau
+ */
+SIMPLEX_API bool append_game_row(Workspace_t* workspace, const double* payoff_row, const SolveOptions_t* options,
+                                 SolveResult_t* result);
+
+#endif